@@ -0,0 +1,247 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Common/CM_Profiler.cpp
+ *  \ingroup common
+ */
+
+#include "CM_Profiler.h"
+#include "CM_Message.h"
+
+#include "BLI_threads.h"
+#include "BLI_string.h"
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+/// Events of a single thread, written only by this thread.
+struct ThreadBuffer
+{
+	std::vector<CM_Profiler::Event> m_events;
+	/// Total number of events recorded, the last events are at this index modulo the capacity.
+	std::atomic<uint64_t> m_count;
+	unsigned int m_id;
+	std::string m_name;
+
+	ThreadBuffer(unsigned int capacity, unsigned int id)
+		:m_events(capacity),
+		m_count(0),
+		m_id(id),
+		m_name("Worker " + std::to_string(id))
+	{
+	}
+};
+
+/// All the thread buffers, only locked when a thread records its first event.
+std::vector<std::unique_ptr<ThreadBuffer> > buffers;
+ThreadMutex buffersMutex = BLI_MUTEX_INITIALIZER;
+
+thread_local ThreadBuffer *threadBuffer = nullptr;
+
+unsigned int bufferCapacity = (1 << 16);
+int64_t timeOrigin = 0;
+
+ThreadBuffer *GetThreadBuffer()
+{
+	if (!threadBuffer) {
+		BLI_mutex_lock(&buffersMutex);
+		buffers.emplace_back(new ThreadBuffer(bufferCapacity, buffers.size()));
+		threadBuffer = buffers.back().get();
+		BLI_mutex_unlock(&buffersMutex);
+	}
+
+	return threadBuffer;
+}
+
+void WriteString(std::ostream& stream, const char *str)
+{
+	stream << '"';
+	for (const char *c = str; *c; ++c) {
+		switch (*c) {
+			case '"':
+			{
+				stream << "\\\"";
+				break;
+			}
+			case '\\':
+			{
+				stream << "\\\\";
+				break;
+			}
+			default:
+			{
+				if ((unsigned char)*c < 0x20) {
+					stream << "\\u00" << std::hex << std::setw(2) << std::setfill('0') << (int)*c << std::dec;
+				}
+				else {
+					stream << *c;
+				}
+			}
+		}
+	}
+	stream << '"';
+}
+
+}
+
+bool CM_Profiler::m_enabled = false;
+
+void CM_Profiler::Enable(unsigned int capacity)
+{
+	// Already created buffers keep their capacity.
+	bufferCapacity = std::max(capacity, 1U);
+	if (!m_enabled) {
+		timeOrigin = GetTime();
+		m_enabled = true;
+	}
+}
+
+void CM_Profiler::Disable()
+{
+	m_enabled = false;
+}
+
+int64_t CM_Profiler::GetTime()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void CM_Profiler::SetThreadName(const std::string& name)
+{
+	ThreadBuffer *buffer = GetThreadBuffer();
+	BLI_mutex_lock(&buffersMutex);
+	buffer->m_name = name;
+	BLI_mutex_unlock(&buffersMutex);
+}
+
+void CM_Profiler::AddEvent(const char *category, const char *name, int64_t begin, int64_t end)
+{
+	ThreadBuffer *buffer = GetThreadBuffer();
+	const uint64_t count = buffer->m_count.load(std::memory_order_relaxed);
+
+	Event& event = buffer->m_events[count % buffer->m_events.size()];
+	event.m_category = category;
+	BLI_strncpy(event.m_name, name, NAME_SIZE);
+	event.m_begin = begin;
+	event.m_end = end;
+
+	buffer->m_count.store(count + 1, std::memory_order_release);
+}
+
+void CM_Profiler::Clear()
+{
+	BLI_mutex_lock(&buffersMutex);
+	for (std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+		buffer->m_count.store(0, std::memory_order_release);
+	}
+	BLI_mutex_unlock(&buffersMutex);
+}
+
+bool CM_Profiler::WriteChromeTrace(const std::string& filepath)
+{
+	std::ofstream file(filepath);
+	if (!file) {
+		CM_Error("can't open profiler trace file \"" << filepath << "\"");
+		return false;
+	}
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	file << std::fixed << std::setprecision(3);
+
+	bool first = true;
+
+	BLI_mutex_lock(&buffersMutex);
+	for (std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+		file << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->m_id
+			 << ",\"args\":{\"name\":";
+		WriteString(file, buffer->m_name.c_str());
+		file << "}}";
+		first = false;
+
+		const uint64_t count = buffer->m_count.load(std::memory_order_acquire);
+		const uint64_t capacity = buffer->m_events.size();
+		// Only the last events are kept once the buffer is full.
+		for (uint64_t i = (count > capacity) ? count - capacity : 0; i < count; ++i) {
+			const Event& event = buffer->m_events[i % capacity];
+			file << ",\n{\"name\":";
+			WriteString(file, event.m_name);
+			file << ",\"cat\":";
+			WriteString(file, event.m_category);
+			file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->m_id
+				 << ",\"ts\":" << double(event.m_begin - timeOrigin) * 1.0e-3
+				 << ",\"dur\":" << double(event.m_end - event.m_begin) * 1.0e-3 << "}";
+		}
+	}
+	BLI_mutex_unlock(&buffersMutex);
+
+	file << "\n]}\n";
+
+	return file.good();
+}
+
+CM_ProfileScope::CM_ProfileScope(const char *category)
+	:m_category(category),
+	m_active(CM_Profiler::IsEnabled())
+{
+	if (m_active) {
+		m_name[0] = '\0';
+		m_begin = CM_Profiler::GetTime();
+	}
+}
+
+CM_ProfileScope::CM_ProfileScope(const char *category, const char *name)
+	:CM_ProfileScope(category)
+{
+	if (m_active) {
+		BLI_strncpy(m_name, name, CM_Profiler::NAME_SIZE);
+	}
+}
+
+CM_ProfileScope::CM_ProfileScope(const char *category, const std::string& name)
+	:CM_ProfileScope(category, name.c_str())
+{
+}
+
+CM_ProfileScope::~CM_ProfileScope()
+{
+	if (m_active) {
+		CM_Profiler::AddEvent(m_category, m_name, m_begin, CM_Profiler::GetTime());
+	}
+}
+
+void CM_ProfileScope::SetName(const std::string& name)
+{
+	BLI_strncpy(m_name, name.c_str(), CM_Profiler::NAME_SIZE);
+}
+
+void CM_ProfileScope::SetName(const std::string& owner, const std::string& name)
+{
+	BLI_snprintf(m_name, CM_Profiler::NAME_SIZE, "%s:%s", owner.c_str(), name.c_str());
+}
@@ -0,0 +1,117 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_Profiler.h
+ *  \ingroup common
+ */
+
+#ifndef __CM_PROFILER_H__
+#define __CM_PROFILER_H__
+
+#include <string>
+#include <cstdint>
+
+/** Scoped events profiler.
+ * Every thread records its events in its own ring buffer without locking, the oldest events
+ * are overwritten when the buffer is full. The events of all the threads are exported in the
+ * Chrome trace event format readable by chrome://tracing and Perfetto. Nested events are displayed
+ * as a hierarchy by these tools as they are sorted by time per thread.
+ */
+class CM_Profiler
+{
+public:
+	enum {
+		NAME_SIZE = 64
+	};
+
+	struct Event
+	{
+		/// Static category name.
+		const char *m_category;
+		char m_name[NAME_SIZE];
+		/// Begin and end time in nanoseconds.
+		int64_t m_begin;
+		int64_t m_end;
+	};
+
+	/** Enable events recording.
+	 * \param capacity The number of events stored per thread.
+	 */
+	static void Enable(unsigned int capacity = (1 << 16));
+	static void Disable();
+
+	static inline bool IsEnabled()
+	{
+		return m_enabled;
+	}
+
+	/// Return the current time in nanoseconds.
+	static int64_t GetTime();
+
+	/// Name the calling thread in the exported trace.
+	static void SetThreadName(const std::string& name);
+
+	/// Record an event in the calling thread buffer.
+	static void AddEvent(const char *category, const char *name, int64_t begin, int64_t end);
+
+	/// Remove all recorded events.
+	static void Clear();
+
+	/** Write all the recorded events in Chrome trace JSON format.
+	 * No event must be recorded during the export.
+	 * \return True if the file was written.
+	 */
+	static bool WriteChromeTrace(const std::string& filepath);
+
+private:
+	static bool m_enabled;
+};
+
+/** Record an event from its construction to its destruction.
+ * Names are copied only when the profiler is enabled, dynamic names should be
+ * set with SetName after checking IsActive to avoid any formatting cost.
+ */
+class CM_ProfileScope
+{
+private:
+	const char *m_category;
+	char m_name[CM_Profiler::NAME_SIZE];
+	int64_t m_begin;
+	bool m_active;
+
+public:
+	explicit CM_ProfileScope(const char *category);
+	CM_ProfileScope(const char *category, const char *name);
+	CM_ProfileScope(const char *category, const std::string& name);
+	~CM_ProfileScope();
+
+	inline bool IsActive() const
+	{
+		return m_active;
+	}
+
+	void SetName(const std::string& name);
+	/// Set a name of format "owner:name".
+	void SetName(const std::string& owner, const std::string& name);
+};
+
+#endif  // __CM_PROFILER_H__
@@ -1264,8 +1264,10 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
 
 	// Convert world.
 	KX_WorldInfo *worldinfo = new KX_WorldInfo(blenderscene, blenderscene->world);
-	worldinfo->UpdateWorldSettings(rendertools);
-	worldinfo->UpdateBackGround(rendertools);
+	if (!rendertools->IsHeadless()) {
+		worldinfo->UpdateWorldSettings(rendertools);
+		worldinfo->UpdateBackGround(rendertools);
+	}
 	kxscene->SetWorldInfo(worldinfo);
 
 	const bool showObstacleSimulation = (blenderscene->gm.flag & GAME_SHOW_OBSTACLE_SIMULATION) != 0;
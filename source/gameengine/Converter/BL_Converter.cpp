@@ -83,6 +83,8 @@ extern "C" {
 }
 
 #include "BLI_task.h"
+#include "PIL_time.h"
+
 #include "CM_Message.h"
 
 #include <cstring>
@@ -127,7 +129,9 @@ void BL_Converter::SceneSlot::Merge(const BL_SceneConverter& converter)
 }
 
 BL_Converter::BL_Converter(Main *maggie, KX_KetsjiEngine *engine)
-	:m_maggie(maggie),
+	:m_mergeState{0, MERGE_MESHES, 0},
+	m_mergeBudget(0.0),
+	m_maggie(maggie),
 	m_ketsjiEngine(engine),
 	m_alwaysUseExpandFraming(false)
 {
@@ -320,34 +324,122 @@ Main *BL_Converter::GetMainDynamicPath(const std::string& path) const
 	return nullptr;
 }
 
-void BL_Converter::MergeAsyncLoads()
+bool BL_Converter::MergeAsyncLoadStep(KX_LibLoadStatus *libload)
 {
-	m_threadinfo.m_mutex.Lock();
+	const std::vector<BL_SceneConverter>& converters = libload->GetSceneConverters();
+	if (m_mergeState.m_converter == converters.size()) {
+		return true;
+	}
 
-	for (KX_LibLoadStatus *libload : m_mergequeue) {
-		KX_Scene *mergeScene = libload->GetMergeScene();
-		for (const BL_SceneConverter& converter : libload->GetSceneConverters()) {
+	const BL_SceneConverter& converter = converters[m_mergeState.m_converter];
+	KX_Scene *mergeScene = libload->GetMergeScene();
+
+	const unsigned int numMaterials = converter.m_materials.size();
+	// Merging is the last 10% of the progress, split between the meshes, the materials and the scene.
+	const float stepProgress = 0.1f / (converters.size() * (converter.m_meshobjects.size() + numMaterials + 1));
+
+	switch (m_mergeState.m_stage) {
+		case MERGE_MESHES:
+		{
+			// Meshes only change their scene, do them all at once.
+			for (KX_Mesh *mesh : converter.m_meshobjects) {
+				mesh->ReplaceScene(mergeScene);
+			}
+			libload->AddProgress(stepProgress * converter.m_meshobjects.size());
+			m_mergeState.m_stage = MERGE_SCENE;
+			break;
+		}
+		case MERGE_SCENE:
+		{
+			// The objects and their physics controllers are merged together.
 			KX_Scene *scene = converter.GetScene();
+
+			/* The objects would render with default shading while their materials are not initialized,
+			 * hide them until the last material step. */
+			if (numMaterials > 0) {
+				for (KX_GameObject *gameobj : *scene->GetObjectList()) {
+					if (gameobj->GetVisible()) {
+						gameobj->SetVisible(false, false);
+						// Keep a reference as the object can be ended before its materials are initialized.
+						gameobj->AddRef();
+						m_mergeState.m_hiddenObjects.push_back(gameobj);
+					}
+				}
+			}
+
 			MergeScene(mergeScene, scene);
-			// Finalize material and mesh conversion.
-			FinalizeSceneData(converter, mergeScene);
 			delete scene;
+			libload->AddProgress(stepProgress);
+
+			if (numMaterials > 0) {
+				m_mergeState.m_stage = MERGE_MATERIALS;
+			}
+			else {
+				m_mergeState = {m_mergeState.m_converter + 1, MERGE_MESHES, 0};
+			}
+			break;
 		}
+		case MERGE_MATERIALS:
+		{
+			/* Materials compile their shaders, do one material per step.
+			 * Do this after lights are available so materials can use the lights in shaders. */
+			converter.m_materials[m_mergeState.m_index++]->InitScene(mergeScene);
+			libload->AddProgress(stepProgress);
+
+			if (m_mergeState.m_index == numMaterials) {
+				ShowMergedObjects();
+				m_mergeState = {m_mergeState.m_converter + 1, MERGE_MESHES, 0};
+			}
+			break;
+		}
+	}
+
+	return (m_mergeState.m_converter == converters.size());
+}
 
-		libload->Finish();
+void BL_Converter::ShowMergedObjects()
+{
+	for (KX_GameObject *gameobj : m_mergeState.m_hiddenObjects) {
+		gameobj->SetVisible(true, false);
+		gameobj->Release();
 	}
+	m_mergeState.m_hiddenObjects.clear();
+}
+
+void BL_Converter::ProceedMergeQueue(double budget)
+{
+	const double starttime = PIL_check_seconds_timer();
+
+	m_threadinfo.m_mutex.Lock();
 
-	m_mergequeue.clear();
+	while (!m_mergequeue.empty()) {
+		KX_LibLoadStatus *libload = m_mergequeue.front();
+		if (MergeAsyncLoadStep(libload)) {
+			m_mergequeue.erase(m_mergequeue.begin());
+			m_mergeState = {0, MERGE_MESHES, 0};
+			libload->Finish();
+		}
+
+		// At least one step is done per call to always progress.
+		if (budget > 0.0 && (PIL_check_seconds_timer() - starttime) * 1000.0 >= budget) {
+			break;
+		}
+	}
 
 	m_threadinfo.m_mutex.Unlock();
 }
 
+void BL_Converter::MergeAsyncLoads()
+{
+	ProceedMergeQueue(m_mergeBudget);
+}
+
 void BL_Converter::FinalizeAsyncLoads()
 {
 	// Finish all loading libraries.
 	BLI_task_pool_work_and_wait(m_threadinfo.m_pool);
 	// Merge all libraries data in the current scene, to avoid memory leak of unmerged scenes.
-	MergeAsyncLoads();
+	ProceedMergeQueue(0.0);
 }
 
 void BL_Converter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
@@ -357,6 +449,16 @@ void BL_Converter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
 	m_threadinfo.m_mutex.Unlock();
 }
 
+double BL_Converter::GetMergeBudget() const
+{
+	return m_mergeBudget;
+}
+
+void BL_Converter::SetMergeBudget(double budget)
+{
+	m_mergeBudget = budget;
+}
+
 static void async_convert(TaskPool *pool, void *ptr, int UNUSED(threadid))
 {
 	KX_LibLoadStatus *status = static_cast<KX_LibLoadStatus *>(ptr);
@@ -640,25 +742,14 @@ bool BL_Converter::FreeBlendFile(Main *maggie)
 
 			// removed tagged objects and meshes
 			EXP_ListValue<KX_GameObject> *obj_lists[] = {scene->GetObjectList(), scene->GetInactiveList(), nullptr};
+			std::vector<KX_GameObject *> tagged_objects;
 
 			for (int ob_ls_idx = 0; obj_lists[ob_ls_idx]; ob_ls_idx++) {
 				EXP_ListValue<KX_GameObject> *obs = obj_lists[ob_ls_idx];
 
-				for (int ob_idx = 0; ob_idx < obs->GetCount(); ob_idx++) {
-					KX_GameObject *gameobj = obs->GetValue(ob_idx);
+				for (KX_GameObject *gameobj : obs) {
 					if (IS_TAGGED(gameobj->GetBlenderObject())) {
-						int size_before = obs->GetCount();
-
-						/* Eventually calls RemoveNodeDestructObject
-						 * frees m_map_gameobject_to_blender from UnregisterGameObject */
-						scene->RemoveObject(gameobj);
-
-						if (size_before != obs->GetCount()) {
-							ob_idx--;
-						}
-						else {
-							CM_Error("could not remove \"" << gameobj->GetName() << "\"");
-						}
+						tagged_objects.push_back(gameobj);
 					}
 					else {
 						gameobj->RemoveTaggedActions();
@@ -692,6 +783,10 @@ bool BL_Converter::FreeBlendFile(Main *maggie)
 					}
 				}
 			}
+
+			/* Eventually calls RemoveNodeDestructObject for each object and its children
+			 * frees m_map_gameobject_to_blender from UnregisterGameObject */
+			scene->RemoveObjects(tagged_objects);
 		}
 	}
 
@@ -54,6 +54,7 @@ class BL_InterpolatorList;
 class SCA_IActuator;
 class SCA_IController;
 class KX_Mesh;
+class KX_GameObject;
 struct Main;
 struct BlendHandle;
 struct Mesh;
@@ -99,12 +100,44 @@ private:
 	std::map<std::string, KX_LibLoadStatus *> m_status_map;
 	std::vector<KX_LibLoadStatus *> m_mergequeue;
 
+	/// Stages of the merge of a scene converted asynchronously.
+	enum MergeStage {
+		MERGE_MESHES = 0,
+		MERGE_SCENE,
+		MERGE_MATERIALS
+	};
+
+	/// Position of the incremental merge in the first library of the merge queue.
+	struct MergeState {
+		/// Index of the scene converter in the library.
+		unsigned int m_converter;
+		MergeStage m_stage;
+		/// Index of the next item to merge in the stage.
+		unsigned int m_index;
+		/// Merged objects hidden until the materials of their converter are initialized.
+		std::vector<KX_GameObject *> m_hiddenObjects;
+	} m_mergeState;
+
+	/// Maximum time spent merging libraries per frame in milliseconds, 0 for no limit.
+	double m_mergeBudget;
+
 	Main *m_maggie;
 	std::vector<Main *> m_DynamicMaggie;
 
 	KX_KetsjiEngine *m_ketsjiEngine;
 	bool m_alwaysUseExpandFraming;
 
+	/** Proceed the merge steps of the libraries in the merge queue.
+	 * \param budget The maximum time spent in milliseconds, 0 for no limit.
+	 */
+	void ProceedMergeQueue(double budget);
+	/** Proceed one merge step of a library.
+	 * \return True when the library is fully merged.
+	 */
+	bool MergeAsyncLoadStep(KX_LibLoadStatus *libload);
+	/// Restore the visibility of the objects hidden during the merge of the current converter.
+	void ShowMergedObjects();
+
 public:
 	BL_Converter(Main *maggie, KX_KetsjiEngine *engine);
 	virtual ~BL_Converter();
@@ -154,10 +187,15 @@ public:
 
 	void MergeScene(KX_Scene *to, KX_Scene *from);
 
+	/// Merge the asynchronously converted libraries within the merge time budget.
 	void MergeAsyncLoads();
+	/// Wait for all the asynchronous conversions and merge all the libraries.
 	void FinalizeAsyncLoads();
 	void AddScenesToMergeQueue(KX_LibLoadStatus *status);
 
+	double GetMergeBudget() const;
+	void SetMergeBudget(double budget);
+
 	void PrintStats();
 
 	// LibLoad Options.
@@ -37,6 +37,7 @@
 #include "BL_ModifierDeformer.h"
 #include "BL_BlenderDataConversion.h"
 #include <string>
+#include <algorithm>
 #include "RAS_IPolygonMaterial.h"
 #include "RAS_MaterialBucket.h"
 #include "RAS_Mesh.h"
@@ -61,6 +62,7 @@ extern "C" {
 	#include "BKE_customdata.h"
 	#include "BKE_DerivedMesh.h"
 	#include "BKE_lattice.h"
+	#include "BKE_mesh.h"
 	#include "BKE_modifier.h"
 }
 
@@ -97,6 +99,8 @@ void BL_ModifierDeformer::ProcessReplica()
 	}
 	// this will force an update and if the mesh cannot be reused, a new one will be created
 	m_lastModifierUpdate = -1.0;
+	// The display arrays of the replica are not converted from the derived mesh yet.
+	m_vertexMapping.clear();
 }
 
 bool BL_ModifierDeformer::HasCompatibleDeformer(Object *ob)
@@ -138,15 +142,22 @@ bool BL_ModifierDeformer::Update(void)
 
 	if (bShapeUpdate || m_lastModifierUpdate != m_gameobj->GetLastFrame()) {
 		// static derived mesh are not updated
-		if (m_dm == nullptr || m_bDynamic) {
+		if (m_dm && m_bDynamic && !m_vertexMapping.empty()) {
+			// The derived mesh topology is constant, only the leading deform modifiers are executed.
+			UpdateMappedVerts(m_gameobj->GetBlenderObject());
+		}
+		else if (m_dm == nullptr || m_bDynamic) {
 			/* execute the modifiers */
 			Object *blendobj = m_gameobj->GetBlenderObject();
+			// Request the original indices to map the derived mesh vertices to the deformed vertices.
+			const bool mappedStack = m_bDynamic && CheckMappedStack(blendobj);
 			/* hack: the modifiers require that the mesh is attached to the object
 			 * It may not be the case here because of replace mesh actuator */
 			Mesh *oldmesh = (Mesh *)blendobj->data;
 			blendobj->data = m_bmesh;
 			/* execute the modifiers */
-			DerivedMesh *dm = mesh_create_derived_no_virtual(m_scene, blendobj, (float (*)[3])m_transverts.data(), CD_MASK_MESH);
+			DerivedMesh *dm = mesh_create_derived_no_virtual(m_scene, blendobj, (float (*)[3])m_transverts.data(),
+					mappedStack ? (CD_MASK_MESH | CD_MASK_ORIGINDEX) : CD_MASK_MESH);
 			/* restore object data */
 			blendobj->data = oldmesh;
 			/* free the current derived mesh and replace, (dm should never be nullptr) */
@@ -167,6 +178,10 @@ bool BL_ModifierDeformer::Update(void)
 
 			UpdateBounds();
 			UpdateTransverts();
+
+			if (mappedStack && !BuildVertexMapping(blendobj)) {
+				RejectMapping();
+			}
 		}
 		m_lastModifierUpdate = m_gameobj->GetLastFrame();
 		bShapeUpdate = true;
@@ -175,6 +190,269 @@ bool BL_ModifierDeformer::Update(void)
 	return bShapeUpdate;
 }
 
+/** Return true if the modifier only produces copies of its input vertices with
+ * a topology not depending on the vertex positions, which is cached by the mapping.
+ */
+static bool modifier_copies_vertices(ModifierData *md, Mesh *me)
+{
+	switch (md->type) {
+		case eModifierType_Triangulate:
+		{
+			// The beauty and shortest edge methods use the positions, as all the n-gon methods.
+			const TriangulateModifierData *tmd = (TriangulateModifierData *)md;
+			if (!ELEM(tmd->quad_method, MOD_TRIANGULATE_QUAD_FIXED, MOD_TRIANGULATE_QUAD_ALTERNATE)) {
+				return false;
+			}
+			for (int i = 0; i < me->totpoly; ++i) {
+				if (me->mpoly[i].totloop > 4) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case eModifierType_EdgeSplit:
+		{
+			// The split by angle uses the face normals.
+			const EdgeSplitModifierData *emd = (EdgeSplitModifierData *)md;
+			return !(emd->flags & MOD_EDGESPLIT_FROMANGLE);
+		}
+		case eModifierType_Mask:
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool BL_ModifierDeformer::CheckMappedStack(Object *blendobj)
+{
+	ModifierData *firstmd = (ModifierData *)blendobj->modifiers.first;
+	// Same as the game engine exception in mesh_calc_modifiers, the armature is applied by the skin deformer.
+	if (firstmd && firstmd->type == eModifierType_Armature) {
+		firstmd = firstmd->next;
+	}
+
+	// The modifiers depending on time are skipped by mesh_create_derived_no_virtual.
+	m_enabledModifiers.clear();
+	for (ModifierData *md = firstmd; md; md = md->next) {
+		if (modifier_isEnabled(m_scene, md, eModifierMode_Realtime) && !modifier_dependsOnTime(md)) {
+			m_enabledModifiers.push_back(md);
+		}
+	}
+
+	if (m_mappingRejected) {
+		if (m_enabledModifiers == m_rejectedModifiers) {
+			return false;
+		}
+		m_mappingRejected = false;
+	}
+
+	if (!IsMappableStack()) {
+		RejectMapping();
+		return false;
+	}
+
+	return true;
+}
+
+bool BL_ModifierDeformer::IsMappableStack()
+{
+	m_deformModifiers.clear();
+
+	// The split normals can't be computed without the whole stack.
+	if (m_bmesh->flag & ME_AUTOSMOOTH) {
+		return false;
+	}
+
+	bool topology = false;
+	for (ModifierData *md : m_enabledModifiers) {
+		const ModifierTypeInfo *mti = modifierType_getInfo((ModifierType)md->type);
+		if (mti->type == eModifierTypeType_OnlyDeform) {
+			// A deformation after a topology change can't be propagated through the mapping.
+			if (topology) {
+				return false;
+			}
+			m_deformModifiers.push_back(md);
+		}
+		else if (modifier_copies_vertices(md, m_bmesh)) {
+			topology = true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void BL_ModifierDeformer::RejectMapping()
+{
+	m_rejectedModifiers = m_enabledModifiers;
+	m_mappingRejected = true;
+	m_vertexMapping.clear();
+}
+
+void BL_ModifierDeformer::DeformVerts(Object *blendobj)
+{
+	m_deformedVerts = m_transverts;
+	if (m_deformModifiers.empty()) {
+		return;
+	}
+
+	/* hack: the modifiers require that the mesh is attached to the object
+	 * It may not be the case here because of replace mesh actuator */
+	Mesh *oldmesh = (Mesh *)blendobj->data;
+	blendobj->data = m_bmesh;
+	// Same as the deform only modifiers at the beginning of the stack in mesh_calc_modifiers.
+	for (ModifierData *md : m_deformModifiers) {
+		modwrap_deformVerts(md, blendobj, nullptr, (float (*)[3])m_deformedVerts.data(), m_deformedVerts.size(),
+				(ModifierApplyFlag)0);
+	}
+	blendobj->data = oldmesh;
+}
+
+bool BL_ModifierDeformer::BuildVertexMapping(Object *blendobj)
+{
+	m_vertexMapping.clear();
+
+	const unsigned int totvert = m_transverts.size();
+	const unsigned int numVerts = m_dm->getNumVerts(m_dm);
+	const int *origindex = (const int *)m_dm->getVertDataArray(m_dm, CD_ORIGINDEX);
+	if (!origindex && numVerts != totvert) {
+		return false;
+	}
+
+	/* Check that the derived mesh vertices are exact copies of the deformed vertices,
+	 * otherwise the whole stack is still executed. */
+	DeformVerts(blendobj);
+	const MVert *mverts = m_dm->getVertArray(m_dm);
+
+	m_vertexMapping.resize(numVerts);
+	for (unsigned int i = 0; i < numVerts; ++i) {
+		const int index = origindex ? origindex[i] : i;
+		if (index < 0 || index >= (int)totvert || !equals_v3v3(mverts[i].co, m_deformedVerts[index].data())) {
+			m_vertexMapping.clear();
+			return false;
+		}
+		m_vertexMapping[i] = index;
+	}
+
+	const MPoly *mpolys = m_dm->getPolyArray(m_dm);
+	const MLoop *mloops = m_dm->getLoopArray(m_dm);
+	const unsigned int numPolys = m_dm->getNumPolys(m_dm);
+	const float (*loopNormals)[3] = (const float (*)[3])m_dm->getLoopDataArray(m_dm, CD_NORMAL);
+	if (!loopNormals) {
+		m_vertexMapping.clear();
+		return false;
+	}
+
+	const unsigned short numSlots = m_slots.size();
+	// Flat vertices of each slot sorted by derived mesh vertex.
+	std::vector<std::vector<std::pair<unsigned int, unsigned int> > > flatVertices(numSlots);
+	m_flatVertexPolys.resize(numSlots);
+	for (unsigned short i = 0; i < numSlots; ++i) {
+		RAS_IDisplayArray *array = m_slots[i].m_displayArray;
+		const unsigned int size = array->GetVertexCount();
+		for (unsigned int j = 0; j < size; ++j) {
+			const RAS_VertexInfo& vinfo = array->GetVertexInfo(j);
+			if (vinfo.GetFlag() & RAS_VertexInfo::FLAT) {
+				flatVertices[i].emplace_back(vinfo.GetOrigIndex(), j);
+			}
+		}
+		std::sort(flatVertices[i].begin(), flatVertices[i].end());
+		m_flatVertexPolys[i].assign(size, -1);
+	}
+
+	/* A flat vertex uses the normal of its polygon, the conversion shares the vertices
+	 * with the same data so the vertex of a polygon loop is the one with the loop normal. */
+	for (unsigned int i = 0; i < numPolys; ++i) {
+		const MPoly& mpoly = mpolys[i];
+		if ((mpoly.flag & ME_SMOOTH) || mpoly.mat_nr >= numSlots) {
+			continue;
+		}
+
+		RAS_IDisplayArray *array = m_slots[mpoly.mat_nr].m_displayArray;
+		const std::vector<std::pair<unsigned int, unsigned int> >& vertices = flatVertices[mpoly.mat_nr];
+		std::vector<int>& polys = m_flatVertexPolys[mpoly.mat_nr];
+
+		for (unsigned int j = mpoly.loopstart, end = mpoly.loopstart + mpoly.totloop; j < end; ++j) {
+			const unsigned int vertid = mloops[j].v;
+			std::vector<std::pair<unsigned int, unsigned int> >::const_iterator it =
+					std::lower_bound(vertices.begin(), vertices.end(), std::make_pair(vertid, 0u));
+			for (; it != vertices.end() && it->first == vertid; ++it) {
+				if (equals_v3v3(array->GetVertex(it->second).GetNormal(), loopNormals[j])) {
+					// Keep the first polygon of a vertex shared by coplanar polygons.
+					if (polys[it->second] == -1) {
+						polys[it->second] = i;
+					}
+					break;
+				}
+			}
+		}
+	}
+
+	const MVert *dmverts = m_dm->getVertArray(m_dm);
+	m_mappedVerts.assign(dmverts, dmverts + numVerts);
+	m_mappedNormals.resize(numVerts);
+	m_polyNormals.resize(numPolys);
+
+	return true;
+}
+
+void BL_ModifierDeformer::UpdateMappedVerts(Object *blendobj)
+{
+	DeformVerts(blendobj);
+
+	const unsigned int numVerts = m_mappedVerts.size();
+	for (unsigned int i = 0; i < numVerts; ++i) {
+		copy_v3_v3(m_mappedVerts[i].co, m_deformedVerts[m_vertexMapping[i]].data());
+	}
+
+	/* Same normals as the derived mesh of the full evaluation: the smooth vertices use
+	 * the vertex normals stored in MVert and the flat vertices their polygon normal. */
+	BKE_mesh_calc_normals_poly(m_mappedVerts.data(), (float (*)[3])m_mappedNormals.data(), numVerts,
+			m_dm->getLoopArray(m_dm), m_dm->getPolyArray(m_dm), m_dm->getNumLoops(m_dm), m_dm->getNumPolys(m_dm),
+			(float (*)[3])m_polyNormals.data(), false);
+
+	mt::vec3 aabbMin(FLT_MAX);
+	mt::vec3 aabbMax(-FLT_MAX);
+	const bool autoUpdate = m_gameobj->GetAutoUpdateBounds();
+
+	for (unsigned short i = 0, numSlots = m_slots.size(); i < numSlots; ++i) {
+		RAS_IDisplayArray *array = m_slots[i].m_displayArray;
+		const std::vector<int>& flatPolys = m_flatVertexPolys[i];
+		for (unsigned int j = 0, size = array->GetVertexCount(); j < size; ++j) {
+			RAS_Vertex v = array->GetVertex(j);
+			const RAS_VertexInfo& vinfo = array->GetVertexInfo(j);
+			const MVert& mvert = m_mappedVerts[vinfo.GetOrigIndex()];
+			v.SetXYZ(mvert.co);
+			if (vinfo.GetFlag() & RAS_VertexInfo::FLAT) {
+				if (flatPolys[j] != -1) {
+					v.SetNormal(m_polyNormals[flatPolys[j]].data());
+				}
+			}
+			else {
+				float normal[3];
+				normal_short_to_float_v3(normal, mvert.no);
+				v.SetNormal(normal);
+			}
+
+			if (autoUpdate) {
+				const mt::vec3 vertpos = v.xyz();
+				aabbMin = mt::vec3::Min(aabbMin, vertpos);
+				aabbMax = mt::vec3::Max(aabbMax, vertpos);
+			}
+		}
+
+		array->NotifyUpdate(RAS_IDisplayArray::POSITION_MODIFIED | RAS_IDisplayArray::NORMAL_MODIFIED);
+	}
+
+	if (autoUpdate) {
+		m_boundingBox->SetAabb(aabbMin, aabbMax);
+	}
+}
+
 void BL_ModifierDeformer::UpdateBounds()
 {
 	float min[3], max[3];
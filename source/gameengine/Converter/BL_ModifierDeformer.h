@@ -42,6 +42,7 @@
 
 class RAS_Mesh;
 struct DerivedMesh;
+struct ModifierData;
 struct Object;
 
 class BL_ModifierDeformer : public BL_ShapeDeformer
@@ -59,7 +60,8 @@ public:
 		:BL_ShapeDeformer(gameobj, bmeshobj_old, bmeshobj_new, mesh, arma),
 		m_lastModifierUpdate(-1),
 		m_scene(scene),
-		m_dm(nullptr)
+		m_dm(nullptr),
+		m_mappingRejected(false)
 	{
 	}
 
@@ -78,9 +80,51 @@ protected:
 	void UpdateBounds();
 	virtual void UpdateTransverts();
 
+	/** Return true if the modifier stack is made of deform only modifiers followed by
+	 * modifiers copying the vertices of their input, and fill m_deformModifiers.
+	 * A leading armature modifier and the modifiers depending on time are skipped as
+	 * in the full evaluation, meshes using split normals are always fully evaluated.
+	 * A rejected stack is not checked again until its enabled modifiers change.
+	 */
+	bool CheckMappedStack(Object *blendobj);
+	/// Return true if the enabled modifiers can be mapped, see CheckMappedStack.
+	bool IsMappableStack();
+	/// Don't use the mapping for the current enabled modifiers.
+	void RejectMapping();
+	/// Apply the leading deform modifiers to m_transverts into m_deformedVerts.
+	void DeformVerts(Object *blendobj);
+	/** Find the deformed vertex copied by each vertex of the derived mesh and
+	 * the polygon of each flat display array vertex, return false if the mapping failed.
+	 */
+	bool BuildVertexMapping(Object *blendobj);
+	/// Update the display arrays from the deformed vertices through the cached vertex mapping.
+	void UpdateMappedVerts(Object *blendobj);
+
 	double m_lastModifierUpdate;
 	Scene *m_scene;
 	DerivedMesh *m_dm;
+
+	/** Leading deform only modifiers of a stack where the remaining modifiers don't move
+	 * the vertices, evaluated alone once the derived mesh topology is known.
+	 */
+	std::vector<ModifierData *> m_deformModifiers;
+	/// Enabled modifiers evaluated by the last full evaluation.
+	std::vector<ModifierData *> m_enabledModifiers;
+	/// Enabled modifiers of the last stack rejected for the mapping.
+	std::vector<ModifierData *> m_rejectedModifiers;
+	bool m_mappingRejected;
+	/// Index of the deformed vertex for each derived mesh vertex, empty if the whole stack is evaluated.
+	std::vector<unsigned int> m_vertexMapping;
+	/// Vertices deformed by m_deformModifiers.
+	std::vector<std::array<float, 3> > m_deformedVerts;
+	/// Derived mesh vertices moved to the deformed vertices, their normals are computed as in the derived mesh.
+	std::vector<MVert> m_mappedVerts;
+	/// Normals per derived mesh vertex.
+	std::vector<std::array<float, 3> > m_mappedNormals;
+	/// Normals per derived mesh polygon.
+	std::vector<std::array<float, 3> > m_polyNormals;
+	/// Derived mesh polygon of each flat vertex per display array slot, -1 for smooth vertices.
+	std::vector<std::vector<int> > m_flatVertexPolys;
 };
 
 #endif  /* __BL_MODIFIERDEFORMER_H__ */
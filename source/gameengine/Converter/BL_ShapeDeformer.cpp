@@ -62,6 +62,32 @@ extern "C" {
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
 
+#ifdef __SSE__
+#  include <xmmintrin.h>
+#endif
+
+/// Add the offsets of a key block multiplied by the key value to the coordinates.
+static void blend_shape_key(const BL_ShapeDeformer::ShapeKeyOffset *offsets, unsigned int count, float value,
+		std::array<float, 4> *coords)
+{
+#ifdef __SSE__
+	const __m128 weight = _mm_set1_ps(value);
+	for (unsigned int i = 0; i < count; ++i) {
+		const BL_ShapeDeformer::ShapeKeyOffset& offset = offsets[i];
+		float *co = coords[offset.origIndex].data();
+		_mm_storeu_ps(co, _mm_add_ps(_mm_loadu_ps(co), _mm_mul_ps(_mm_loadu_ps(offset.offset), weight)));
+	}
+#else
+	for (unsigned int i = 0; i < count; ++i) {
+		const BL_ShapeDeformer::ShapeKeyOffset& offset = offsets[i];
+		std::array<float, 4>& co = coords[offset.origIndex];
+		co[0] += offset.offset[0] * value;
+		co[1] += offset.offset[1] * value;
+		co[2] += offset.offset[2] * value;
+	}
+#endif
+}
+
 BL_ShapeDeformer::BL_ShapeDeformer(BL_DeformableGameObject *gameobj,
                                    Object *bmeshobj_old,
                                    Object *bmeshobj_new,
@@ -72,6 +98,11 @@ BL_ShapeDeformer::BL_ShapeDeformer(BL_DeformableGameObject *gameobj,
 	m_lastShapeUpdate(-1)
 {
 	m_key = m_bmesh->key ? BKE_key_copy(G.main, m_bmesh->key) : nullptr;
+
+	if (m_key) {
+		UpdateKeyBlocks();
+		PackShapeKeys(gameobj->GetBlenderObject());
+	}
 }
 
 BL_ShapeDeformer::~BL_ShapeDeformer()
@@ -97,6 +128,96 @@ void BL_ShapeDeformer::ProcessReplica()
 	m_lastShapeUpdate = -1;
 
 	m_key = m_key ? BKE_key_copy(G.main, m_key) : nullptr;
+	UpdateKeyBlocks();
+}
+
+void BL_ShapeDeformer::UpdateKeyBlocks()
+{
+	m_keyBlocks.clear();
+	if (!m_key) {
+		return;
+	}
+
+	for (KeyBlock *kb = (KeyBlock *)m_key->block.first; kb; kb = kb->next) {
+		m_keyBlocks.push_back(kb);
+	}
+}
+
+void BL_ShapeDeformer::PackShapeKeys(Object *blendobj)
+{
+	const unsigned int totvert = m_bmesh->totvert;
+	m_shapeKeys.reset(new ShapeKeyData());
+	ShapeKeyData& data = *m_shapeKeys;
+
+	KeyBlock *refkey = m_key->refkey;
+	const float (*refco)[3] = (refkey && refkey->totelem == (int)totvert) ? (const float (*)[3])refkey->data : nullptr;
+	data.basis.resize(totvert);
+	for (unsigned int v = 0; v < totvert; ++v) {
+		const float *co = refco ? refco[v] : m_bmesh->mvert[v].co;
+		data.basis[v] = {{co[0], co[1], co[2], 0.0f}};
+	}
+
+	// The vertex group weights are constant, they are premultiplied to the offsets.
+	WeightsArrayCache cache = {0, nullptr};
+	float **per_keyblock_weights = BKE_keyblock_get_per_block_weights(blendobj, m_key, &cache);
+
+	for (unsigned int i = 0, size = m_keyBlocks.size(); i < size; ++i) {
+		const KeyBlock *kb = m_keyBlocks[i];
+		if (kb == refkey || kb->totelem != (int)totvert) {
+			continue;
+		}
+
+		const KeyBlock *refb = (KeyBlock *)BLI_findlink(&m_key->block, kb->relative);
+		if (!refb || refb == kb || refb->totelem != (int)totvert) {
+			continue;
+		}
+
+		const float (*from)[3] = (const float (*)[3])kb->data;
+		const float (*reffrom)[3] = (const float (*)[3])refb->data;
+		const float *weights = per_keyblock_weights[i];
+
+		const unsigned int start = data.offsets.size();
+		for (unsigned int v = 0; v < totvert; ++v) {
+			const float weight = weights ? weights[v] : 1.0f;
+			float offset[3];
+			sub_v3_v3v3(offset, from[v], reffrom[v]);
+			mul_v3_fl(offset, weight);
+
+			// Store only the moved vertices.
+			if (is_zero_v3(offset)) {
+				continue;
+			}
+
+			data.offsets.push_back({{offset[0], offset[1], offset[2], 0.0f}, v});
+		}
+
+		if (data.offsets.size() > start) {
+			data.keys.push_back({i, start, (unsigned int)data.offsets.size()});
+		}
+	}
+
+	BKE_keyblock_free_per_block_weights(m_key, per_keyblock_weights, &cache);
+}
+
+void BL_ShapeDeformer::BlendShapeKeys()
+{
+	const ShapeKeyData& data = *m_shapeKeys;
+	m_shapeCoords.assign(data.basis.begin(), data.basis.end());
+
+	for (const ShapeKeyRange& range : data.keys) {
+		const KeyBlock *kb = m_keyBlocks[range.keyIndex];
+		// Most of the keys are unused at a time.
+		if ((kb->flag & KEYBLOCK_MUTE) || kb->curval == 0.0f) {
+			continue;
+		}
+
+		blend_shape_key(&data.offsets[range.start], range.end - range.start, kb->curval, m_shapeCoords.data());
+	}
+
+	for (unsigned int v = 0, size = m_shapeCoords.size(); v < size; ++v) {
+		const std::array<float, 4>& co = m_shapeCoords[v];
+		m_transverts[v] = {{co[0], co[1], co[2]}};
+	}
 }
 
 bool BL_ShapeDeformer::LoadShapeDrivers(KX_GameObject *parent)
@@ -158,28 +279,18 @@ bool BL_ShapeDeformer::Update()
 	/* See if the object shape has changed */
 	if (m_lastShapeUpdate != m_gameobj->GetLastFrame()) {
 		/* the key coefficient have been set already, we just need to blend the keys */
-		Object *blendobj = m_gameobj->GetBlenderObject();
 
 		/* we will blend the key directly in m_transverts array: it is used by armature as the start position */
 		/* m_key can be nullptr in case of Modifier deformer */
 		if (m_key) {
-			WeightsArrayCache cache = {0, nullptr};
-			float **per_keyblock_weights;
-
 			/* store verts locally */
 			VerifyStorage();
 
-			per_keyblock_weights = BKE_keyblock_get_per_block_weights(blendobj, m_key, &cache);
-			BKE_key_evaluate_relative(0, m_bmesh->totvert, m_bmesh->totvert, (char *)(float *)m_transverts.data(),
-			                          m_key, nullptr, per_keyblock_weights, 0); /* last arg is ignored */
-			BKE_keyblock_free_per_block_weights(m_key, per_keyblock_weights, &cache);
+			BlendShapeKeys();
 
 			m_bDynamic = true;
 		}
 
-		// Don't release the weight array as in Blender, it will most likely be reusable on next frame
-		// The weight array are ultimately deleted when the skin mesh is destroyed
-
 		/* Update the current frame */
 		m_lastShapeUpdate = m_gameobj->GetLastFrame();
 
@@ -39,14 +39,43 @@
 #include "BL_SkinDeformer.h"
 #include "BL_DeformableGameObject.h"
 #include <vector>
+#include <array>
+#include <memory>
 
 struct Object;
 struct Key;
+struct KeyBlock;
 class RAS_Mesh;
 
 class BL_ShapeDeformer : public BL_SkinDeformer
 {
 public:
+	/// Offset of a vertex from the reference key, premultiplied by the vertex group weight of the key.
+	struct ShapeKeyOffset
+	{
+		/// Padded to 4 floats for SIMD.
+		float offset[4];
+		unsigned int origIndex;
+	};
+
+	/// Range of non null offsets of a key block.
+	struct ShapeKeyRange
+	{
+		/// Index of the key block in the key.
+		unsigned int keyIndex;
+		unsigned int start;
+		unsigned int end;
+	};
+
+	/// Relative shape keys packed at conversion.
+	struct ShapeKeyData
+	{
+		/// Coordinates of the reference key.
+		std::vector<std::array<float, 4> > basis;
+		std::vector<ShapeKeyRange> keys;
+		std::vector<ShapeKeyOffset> offsets;
+	};
+
 	BL_ShapeDeformer(BL_DeformableGameObject *gameobj,
 					 Object *bmeshobj_old,
 					 Object *bmeshobj_new,
@@ -72,6 +101,18 @@ protected:
 	bool m_useShapeDrivers;
 	double m_lastShapeUpdate;
 	Key *m_key;
+	/// Key blocks of m_key by index, used to read the current key values.
+	std::vector<KeyBlock *> m_keyBlocks;
+	/// Shape keys packed at conversion and shared with the replicas.
+	std::shared_ptr<ShapeKeyData> m_shapeKeys;
+	/// Coordinates blended from the shape keys, padded to 4 floats.
+	std::vector<std::array<float, 4> > m_shapeCoords;
+
+	/// Pack the offsets of the key blocks, blendobj is used to get the key vertex groups.
+	void PackShapeKeys(Object *blendobj);
+	void UpdateKeyBlocks();
+	/// Blend the key blocks of non null value into m_transverts.
+	void BlendShapeKeys();
 };
 
 #endif
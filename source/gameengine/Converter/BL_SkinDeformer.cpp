@@ -64,6 +64,97 @@ extern "C" {
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
+
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+
+#include <algorithm>
+
+#ifdef __SSE__
+#  include <xmmintrin.h>
+#endif
+
+/// Minimum number of vertices deformed by a single task.
+#define SKIN_TASK_SIZE 4096
+
+/// Packed vertices deformed by a task.
+struct SkinTaskData
+{
+	const BL_SkinDeformer::SkinVertex *vertices;
+	unsigned int count;
+	const BL_SkinDeformer::SkinMatrix *matrices;
+	const MVert *mverts;
+	std::array<float, 3> *transverts;
+	std::array<float, 3> *transnors;
+};
+
+/** Linear blend skinning of the packed vertices, the position is transformed by the
+ * weighted sum of the group matrices and the normal by the rotation of the main group.
+ */
+static void skin_vertices(const SkinTaskData& data)
+{
+	for (unsigned int i = 0; i < data.count; ++i) {
+		const BL_SkinDeformer::SkinVertex& vertex = data.vertices[i];
+		std::array<float, 3>& co = data.transverts[vertex.origIndex];
+		std::array<float, 3>& no = data.transnors[vertex.origIndex];
+		const short *normorg = data.mverts[vertex.origIndex].no;
+		const BL_SkinDeformer::SkinMatrix& main = data.matrices[vertex.groups[0]];
+
+#ifdef __SSE__
+		__m128 col0 = _mm_setzero_ps();
+		__m128 col1 = _mm_setzero_ps();
+		__m128 col2 = _mm_setzero_ps();
+		__m128 col3 = _mm_setzero_ps();
+
+		for (unsigned short j = 0; j < BL_SkinDeformer::MAX_VERTEX_GROUPS; ++j) {
+			const BL_SkinDeformer::SkinMatrix& matrix = data.matrices[vertex.groups[j]];
+			const __m128 weight = _mm_set1_ps(vertex.weights[j]);
+
+			col0 = _mm_add_ps(col0, _mm_mul_ps(_mm_loadu_ps(matrix.position[0]), weight));
+			col1 = _mm_add_ps(col1, _mm_mul_ps(_mm_loadu_ps(matrix.position[1]), weight));
+			col2 = _mm_add_ps(col2, _mm_mul_ps(_mm_loadu_ps(matrix.position[2]), weight));
+			col3 = _mm_add_ps(col3, _mm_mul_ps(_mm_loadu_ps(matrix.position[3]), weight));
+		}
+
+		const __m128 position = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(col0, _mm_set1_ps(co[0])), _mm_mul_ps(col1, _mm_set1_ps(co[1]))),
+			_mm_add_ps(_mm_mul_ps(col2, _mm_set1_ps(co[2])), col3));
+		const __m128 normal = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(main.normal[0]), _mm_set1_ps(normorg[0])),
+			           _mm_mul_ps(_mm_loadu_ps(main.normal[1]), _mm_set1_ps(normorg[1]))),
+			_mm_mul_ps(_mm_loadu_ps(main.normal[2]), _mm_set1_ps(normorg[2])));
+
+		float result[4];
+		_mm_storeu_ps(result, position);
+		co = {{result[0], result[1], result[2]}};
+		_mm_storeu_ps(result, normal);
+		no = {{result[0], result[1], result[2]}};
+#else
+		float matrix[4][3] = {{0.0f}};
+		for (unsigned short j = 0; j < BL_SkinDeformer::MAX_VERTEX_GROUPS; ++j) {
+			const BL_SkinDeformer::SkinMatrix& groupMatrix = data.matrices[vertex.groups[j]];
+			const float weight = vertex.weights[j];
+			for (unsigned short c = 0; c < 4; ++c) {
+				for (unsigned short r = 0; r < 3; ++r) {
+					matrix[c][r] += groupMatrix.position[c][r] * weight;
+				}
+			}
+		}
+
+		const std::array<float, 3> orig = co;
+		for (unsigned short r = 0; r < 3; ++r) {
+			co[r] = matrix[0][r] * orig[0] + matrix[1][r] * orig[1] + matrix[2][r] * orig[2] + matrix[3][r];
+			no[r] = main.normal[0][r] * normorg[0] + main.normal[1][r] * normorg[1] + main.normal[2][r] * normorg[2];
+		}
+#endif
+	}
+}
+
+static void skin_vertices_task_func(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	skin_vertices(*(SkinTaskData *)taskdata);
+}
 
 static short get_deformflags(Object *bmeshobj)
 {
@@ -98,6 +189,10 @@ BL_SkinDeformer::BL_SkinDeformer(
 	// simulate a pure replacement of the mesh.
 	copy_m4_m4(m_obmat, bmeshobj_new->obmat);
 	m_deformflags = get_deformflags(bmeshobj_new);
+
+	if (m_armobj) {
+		PackSkinVertices();
+	}
 }
 
 BL_SkinDeformer::~BL_SkinDeformer()
@@ -163,15 +258,91 @@ void BL_SkinDeformer::BlenderDeformVerts()
 	RecalcNormals();
 }
 
-void BL_SkinDeformer::BGEDeformVerts()
+void BL_SkinDeformer::PackSkinVertices()
 {
+	const MDeformVert *dverts = m_bmesh->dvert;
+	if (!dverts) {
+		return;
+	}
+
 	Object *par_arma = m_armobj->GetArmatureObject();
-	MDeformVert *dverts = m_bmesh->dvert;
-	Eigen::Matrix4f pre_mat, post_mat, chan_mat, norm_chan_mat;
+	const unsigned short defbase_tot = BLI_listbase_count(&m_objMesh->defbase);
+
+	// Deform groups matching a deforming bone of the armature.
+	std::vector<bool> deformGroups(defbase_tot, false);
+	int i;
+	bDeformGroup *dg;
+	for (i = 0, dg = (bDeformGroup *)m_objMesh->defbase.first; dg; ++i, dg = dg->next) {
+		bPoseChannel *pchan = BKE_pose_channel_find_name(par_arma->pose, dg->name);
+		deformGroups[i] = (pchan && !(pchan->bone->flag & BONE_NO_DEFORM));
+	}
+
+	m_skinVertices.reset(new std::vector<SkinVertex>());
+	std::vector<SkinVertex>& skinVertices = *m_skinVertices;
+
+	for (unsigned int v = 0, totvert = m_bmesh->totvert; v < totvert; ++v) {
+		const MDeformVert& dv = dverts[v];
+		SkinVertex vertex = {v, {0}, {0.0f}};
+		unsigned short count = 0;
+
+		// Keep the heaviest groups sorted by decreasing weight, the first group is used for the normal.
+		for (unsigned int j = 0; j < dv.totweight; ++j) {
+			const MDeformWeight& dw = dv.dw[j];
+			if (dw.def_nr >= defbase_tot || !deformGroups[dw.def_nr] || dw.weight == 0.0f) {
+				continue;
+			}
+
+			unsigned short pos;
+			if (count < MAX_VERTEX_GROUPS) {
+				pos = count++;
+			}
+			else if (dw.weight > vertex.weights[MAX_VERTEX_GROUPS - 1]) {
+				pos = MAX_VERTEX_GROUPS - 1;
+			}
+			else {
+				continue;
+			}
+
+			for (; pos > 0 && vertex.weights[pos - 1] < dw.weight; --pos) {
+				vertex.groups[pos] = vertex.groups[pos - 1];
+				vertex.weights[pos] = vertex.weights[pos - 1];
+			}
+			vertex.groups[pos] = dw.def_nr;
+			vertex.weights[pos] = dw.weight;
+		}
 
-	if (!dverts)
+		if (count == 0) {
+			continue;
+		}
+
+		float contrib = 0.0f;
+		for (unsigned short j = 0; j < count; ++j) {
+			contrib += vertex.weights[j];
+		}
+		for (unsigned short j = 0; j < count; ++j) {
+			vertex.weights[j] /= contrib;
+		}
+		for (unsigned short j = count; j < MAX_VERTEX_GROUPS; ++j) {
+			vertex.groups[j] = vertex.groups[0];
+		}
+
+		skinVertices.push_back(vertex);
+	}
+
+	// Vertices using the same groups are deformed with the same matrices, keep them close.
+	std::stable_sort(skinVertices.begin(), skinVertices.end(), [](const SkinVertex& vert1, const SkinVertex& vert2) {
+		return std::lexicographical_compare(vert1.groups, vert1.groups + MAX_VERTEX_GROUPS,
+				vert2.groups, vert2.groups + MAX_VERTEX_GROUPS);
+	});
+}
+
+void BL_SkinDeformer::BGEDeformVerts()
+{
+	if (!m_skinVertices) {
 		return;
+	}
 
+	Object *par_arma = m_armobj->GetArmatureObject();
 	const unsigned short defbase_tot = BLI_listbase_count(&m_objMesh->defbase);
 
 	if (m_dfnrToPC.empty()) {
@@ -187,66 +358,60 @@ void BL_SkinDeformer::BGEDeformVerts()
 		}
 	}
 
-	post_mat = Eigen::Matrix4f::Map((float *)m_obmat).inverse() * Eigen::Matrix4f::Map((float *)m_armobj->GetArmatureObject()->obmat);
-	pre_mat = post_mat.inverse();
-
-	MDeformVert *dv = dverts;
-	MDeformWeight *dw;
-
-	for (int i = 0; i < m_bmesh->totvert; ++i, dv++) {
-		float contrib = 0.0f, weight, max_weight = -1.0f;
-		bPoseChannel *pchan = nullptr;
-		Eigen::Vector3f normorg(m_bmesh->mvert[i].no[0], m_bmesh->mvert[i].no[1], m_bmesh->mvert[i].no[2]);
-		Eigen::Map<Eigen::Vector3f> norm = Eigen::Vector3f::Map(m_transnors[i].data());
-		Eigen::Vector4f vec(0.0f, 0.0f, 0.0f, 1.0f);
-		Eigen::Vector4f co(m_transverts[i][0],
-		                   m_transverts[i][1],
-		                   m_transverts[i][2],
-		                   1.0f);
-
-		if (!dv->totweight)
+	const Eigen::Matrix4f post_mat = Eigen::Matrix4f::Map((float *)m_obmat).inverse() * Eigen::Matrix4f::Map((float *)par_arma->obmat);
+	const Eigen::Matrix4f pre_mat = post_mat.inverse();
+
+	/* The vertex is moved in armature space by the weighted sum of the channel matrices,
+	 * merge the space conversions in the matrix of each group. */
+	m_skinMatrices.resize(defbase_tot);
+	for (unsigned short i = 0; i < defbase_tot; ++i) {
+		SkinMatrix& matrix = m_skinMatrices[i];
+		Eigen::Map<Eigen::Matrix4f> position((float *)matrix.position);
+		Eigen::Map<Eigen::Matrix<float, 4, 3> > normal((float *)matrix.normal);
+
+		bPoseChannel *pchan = m_dfnrToPC[i];
+		if (!pchan) {
+			position.setIdentity();
+			normal.setIdentity();
 			continue;
-
-		co = pre_mat * co;
-
-		dw = dv->dw;
-
-		for (unsigned int j = dv->totweight; j != 0; j--, dw++) {
-			const int index = dw->def_nr;
-
-			if (index < defbase_tot && (pchan = m_dfnrToPC[index])) {
-				weight = dw->weight;
-
-				if (weight) {
-					chan_mat = Eigen::Matrix4f::Map((float *)pchan->chan_mat);
-
-					// Update Vertex Position
-					vec.noalias() += (chan_mat * co - co) * weight;
-
-					// Save the most influential channel so we can use it to update the vertex normal
-					if (weight > max_weight)
-					{
-						max_weight = weight;
-						norm_chan_mat = chan_mat;
-					}
-
-					contrib += weight;
-				}
-			}
 		}
 
-		// Update Vertex Normal
-		norm = norm_chan_mat.topLeftCorner<3, 3>() * normorg;
+		const Eigen::Matrix4f chan_mat = Eigen::Matrix4f::Map((float *)pchan->chan_mat);
+		position = post_mat * chan_mat * pre_mat;
+		normal = chan_mat.leftCols<3>();
+		normal.row(3).setZero();
+	}
 
-		co.noalias() += vec / contrib;
-		co[3] = 1.0f; // Make sure we have a 1 for the w component!
+	const unsigned int count = m_skinVertices->size();
+	const SkinTaskData data = {m_skinVertices->data(), count, m_skinMatrices.data(), m_bmesh->mvert,
+			m_transverts.data(), m_transnors.data()};
 
-		co = post_mat * co;
+	if (count < SKIN_TASK_SIZE * 2) {
+		skin_vertices(data);
+	}
+	else {
+		// Split large meshes over the engine task scheduler.
+		TaskScheduler *scheduler = KX_GetActiveEngine()->GetTaskScheduler();
+		const unsigned int numThreads = BLI_task_scheduler_num_threads(scheduler);
+		const unsigned int taskSize = std::max((unsigned int)SKIN_TASK_SIZE, count / numThreads + 1);
+
+		std::vector<SkinTaskData> tasks;
+		for (unsigned int start = 0; start < count; start += taskSize) {
+			SkinTaskData task = data;
+			task.vertices += start;
+			task.count = std::min(taskSize, count - start);
+			tasks.push_back(task);
+		}
 
-		m_transverts[i][0] = co[0];
-		m_transverts[i][1] = co[1];
-		m_transverts[i][2] = co[2];
+		// Created here as the deformers are updated from the animation tasks.
+		TaskPool *pool = BLI_task_pool_create(scheduler, nullptr);
+		for (SkinTaskData& task : tasks) {
+			BLI_task_pool_push(pool, skin_vertices_task_func, &task, false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
 	}
+
 	m_copyNormals = true;
 }
 
@@ -46,6 +46,8 @@
 
 #include "RAS_Deformer.h"
 
+#include <memory>
+
 struct Object;
 struct bPoseChannel;
 class RAS_Mesh;
@@ -54,6 +56,28 @@ class RAS_IPolyMaterial;
 class BL_SkinDeformer : public BL_MeshDeformer
 {
 public:
+	/// Maximum number of deform groups used per vertex by the BGE CPU deformation.
+	static const unsigned short MAX_VERTEX_GROUPS = 4;
+
+	/** Deform groups and normalized weights of a vertex, sorted by decreasing weight.
+	 * Unused groups have a null weight and the index of the first group.
+	 */
+	struct SkinVertex
+	{
+		unsigned int origIndex;
+		unsigned short groups[MAX_VERTEX_GROUPS];
+		float weights[MAX_VERTEX_GROUPS];
+	};
+
+	/// Deformation matrices of a deform group in column major order.
+	struct SkinMatrix
+	{
+		/// Mesh space transform of the vertex position.
+		float position[4][4];
+		/// Pose channel rotation used for the vertex normal.
+		float normal[3][4];
+	};
+
 	virtual void Relink(std::map<SCA_IObject *, SCA_IObject *>& map);
 
 	BL_SkinDeformer(BL_DeformableGameObject *gameobj,
@@ -94,6 +118,15 @@ protected:
 	bool m_copyNormals; // dirty flag so we know if Apply() needs to copy normal information (used for BGEDeformVerts())
 	std::vector<bPoseChannel *> m_dfnrToPC;
 	short m_deformflags;
+	/** Weighted vertices packed at conversion, sorted by deform groups and
+	 * shared with the replicas.
+	 */
+	std::shared_ptr<std::vector<SkinVertex> > m_skinVertices;
+	/// Deformation matrices per deform group, updated before each BGE deformation.
+	std::vector<SkinMatrix> m_skinMatrices;
+
+	/// Pack the weights of the mesh vertices deformed by the armature.
+	void PackSkinVertices();
 
 	void BlenderDeformVerts();
 	void BGEDeformVerts();
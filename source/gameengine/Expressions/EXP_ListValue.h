@@ -106,6 +106,19 @@ public:
 		return nullptr;
 	}
 
+	/** Remove all the values for which the function returns true in a single pass
+	 * preserving the order of the other values, the values are not released.
+	 * \return The number of removed values.
+	 */
+	unsigned int RemoveIf(std::function<bool (ItemType *)> function)
+	{
+		const VectorTypeIterator it = std::remove_if(m_valueArray.begin(), m_valueArray.end(),
+			[&function](EXP_Value *val) { return function(static_cast<ItemType *>(val)); });
+		const unsigned int count = m_valueArray.end() - it;
+		m_valueArray.erase(it, m_valueArray.end());
+		return count;
+	}
+
 	void MergeList(EXP_ListValue<ItemType> *otherlist)
 	{
 		const unsigned int numelements = GetCount();
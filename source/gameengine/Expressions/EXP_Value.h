@@ -134,6 +134,10 @@ public:
 	virtual std::vector<std::string>    GetPropertyNames();
 	/// Clear all properties.
 	virtual void ClearProperties();
+	/** Reset the properties to the ones of <other>, the properties of same name and type
+	 * are set in place, the others are replicated or removed.
+	 */
+	void ResetProperties(EXP_Value *other);
 
 	/// Get property number <inIndex>.
 	virtual EXP_Value *GetProperty(int inIndex);
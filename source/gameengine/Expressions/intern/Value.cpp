@@ -232,6 +232,39 @@ void EXP_Value::ClearProperties()
 	m_properties.clear();
 }
 
+/// Reset the properties to the ones of <other>.
+void EXP_Value::ResetProperties(EXP_Value *other)
+{
+	// Both maps are sorted by name, merge them in a single pass.
+	std::map<std::string, EXP_Value *>::iterator it = m_properties.begin();
+	for (const auto& pair : other->m_properties) {
+		// Remove the properties missing in the other value.
+		while (it != m_properties.end() && it->first < pair.first) {
+			it->second->Release();
+			it = m_properties.erase(it);
+		}
+
+		if (it != m_properties.end() && it->first == pair.first) {
+			if (it->second->GetValueType() == pair.second->GetValueType()) {
+				it->second->SetValue(pair.second);
+			}
+			else {
+				it->second->Release();
+				it->second = pair.second->GetReplica();
+			}
+			++it;
+		}
+		else {
+			it = ++m_properties.emplace_hint(it, pair.first, pair.second->GetReplica());
+		}
+	}
+
+	while (it != m_properties.end()) {
+		it->second->Release();
+		it = m_properties.erase(it);
+	}
+}
+
 /// Get property number <inIndex>.
 EXP_Value *EXP_Value::GetProperty(int inIndex)
 {
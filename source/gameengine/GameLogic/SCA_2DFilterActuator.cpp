@@ -32,6 +32,7 @@
 #include "RAS_2DFilterData.h"
 #include "RAS_2DFilterManager.h"
 #include "RAS_2DFilter.h"
+#include "RAS_Rasterizer.h"
 
 #include "CM_Message.h"
 
@@ -112,7 +113,11 @@ bool SCA_2DFilterActuator::Update()
 		}
 		default:
 		{
-			if (!filter) {
+			// The filter shaders need a render context.
+			if (m_rasterizer->IsHeadless()) {
+				CM_LogicBrickError(this, "2D filters are not available in headless mode, do nothing.");
+			}
+			else if (!filter) {
 				RAS_2DFilterData info;
 				info.filterPassIndex = m_int_arg;
 				info.gameObject = m_gameobj;
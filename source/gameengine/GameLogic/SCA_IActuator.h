@@ -52,8 +52,6 @@ protected:
 
 	std::vector<SCA_IController *> m_linkedcontrollers;
 
-	void RemoveAllEvents();
-
 public:
 	/**
 	 * This class also inherits the default copy constructors
@@ -117,6 +115,8 @@ public:
 	 * Add an event to an actuator.
 	 */
 	void AddEvent(bool event);
+	/// Remove the positive and negative events received since the last update.
+	void RemoveAllEvents();
 
 	virtual void ProcessReplica();
 
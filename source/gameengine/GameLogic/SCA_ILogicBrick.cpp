@@ -54,6 +54,12 @@ SCA_ILogicBrick::~SCA_ILogicBrick()
 	RemoveEvent();
 }
 
+void SCA_ILogicBrick::ProcessReplica()
+{
+	EXP_Value::ProcessReplica();
+	m_cost.Reset();
+}
+
 
 
 void SCA_ILogicBrick::SetExecutePriority(int execute_Priority)
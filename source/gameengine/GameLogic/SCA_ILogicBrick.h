@@ -35,6 +35,7 @@
 #include "EXP_Value.h"
 #include "SCA_IObject.h"
 #include "EXP_BoolValue.h"
+#include "SCA_LogicCost.h"
 
 class KX_NetworkMessageScene;
 class SCA_IScene;
@@ -52,6 +53,8 @@ protected:
 	bool				m_bActive;
 	EXP_Value*				m_eventval;
 	std::string			m_name;
+	/// Cost counters, updated only when the logic manager collects the costs.
+	SCA_LogicCost m_cost;
 	//unsigned long		m_drawcolor;
 	void RemoveEvent();
 
@@ -59,6 +62,8 @@ public:
 	SCA_ILogicBrick(SCA_IObject* gameobj);
 	virtual ~SCA_ILogicBrick();
 
+	virtual void ProcessReplica();
+
 	void SetExecutePriority(int execute_Priority);
 	void SetUeberExecutePriority(int execute_Priority);
 
@@ -70,6 +75,11 @@ public:
 
 	virtual std::string GetName();
 	virtual void		SetName(const std::string& name);
+
+	SCA_LogicCost& GetCost()
+	{
+		return m_cost;
+	}
 		
 	bool				IsActive()
 	{
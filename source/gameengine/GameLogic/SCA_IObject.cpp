@@ -74,16 +74,10 @@ SCA_IObject::~SCA_IObject()
 		// Use Delete for controller to ensure proper cleaning (expression controller).
 		controller->Delete();
 	}
-	for (SCA_IActuator *actuator : m_registeredActuators) {
-		actuator->UnlinkObject(this);
-	}
+	UnlinkRegisteredClients();
 	for (SCA_IActuator *actuator : m_actuators) {
 		actuator->Delete();
 	}
-
-	for (SCA_IObject *object : m_registeredObjects) {
-		object->UnlinkObject(this);
-	}
 }
 
 SCA_ControllerList& SCA_IObject::GetControllers()
@@ -174,6 +168,19 @@ bool SCA_IObject::UnlinkObject(SCA_IObject *clientobj)
 	return false;
 }
 
+void SCA_IObject::UnlinkRegisteredClients()
+{
+	for (SCA_IActuator *actuator : m_registeredActuators) {
+		actuator->UnlinkObject(this);
+	}
+	m_registeredActuators.clear();
+
+	for (SCA_IObject *object : m_registeredObjects) {
+		object->UnlinkObject(this);
+	}
+	m_registeredObjects.clear();
+}
+
 void SCA_IObject::ReParentLogic()
 {
 	SCA_ActuatorList& oldactuators = GetActuators();
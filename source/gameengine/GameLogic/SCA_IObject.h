@@ -124,6 +124,10 @@ public:
 	 * returns true if there was indeed a reference.
 	 */
 	virtual bool UnlinkObject(SCA_IObject *clientobj);
+	/** Inform all the registered actuators and objects that this object is deleted,
+	 * they drop their reference to it and are unregistered.
+	 */
+	void UnlinkRegisteredClients();
 
 	SCA_ISensor *FindSensor(const std::string& sensorname);
 	SCA_IActuator *FindActuator(const std::string& actuatorname);
@@ -40,6 +40,7 @@
 
 #include "CM_Message.h"
 #include "CM_List.h"
+#include "CM_Profiler.h"
 
 void SCA_ISensor::ReParent(SCA_IObject *parent)
 {
@@ -254,6 +255,12 @@ void SCA_ISensor::Activate(class SCA_LogicManager *logicmgr)
 	 * don't evaluate a sensor that is not connected to any controller
 	 */
 	if (m_links && !m_suspended) {
+		CM_ProfileScope profileScope("sensor");
+		if (profileScope.IsActive()) {
+			profileScope.SetName(GetParent()->GetName(), GetName());
+		}
+		SCA_LogicCostScope costScope(logicmgr->GetCostProfile() ? &m_cost : nullptr);
+
 		bool result = this->Evaluate();
 		// store the state for the rest of the logic system
 		m_prev_state = m_state;
@@ -0,0 +1,110 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SCA_LogicCost.h
+ *  \ingroup gamelogic
+ */
+
+#ifndef __SCA_LOGICCOST_H__
+#define __SCA_LOGICCOST_H__
+
+#include "CM_Profiler.h"
+
+#include <algorithm>
+
+/** Cost counters of a logic brick or a python component.
+ * Bricks and components are called at most once per logic frame,
+ * the worst call time is then the worst logic frame time.
+ */
+class SCA_LogicCost
+{
+private:
+	unsigned int m_calls;
+	/// Cumulative and worst call time in seconds.
+	double m_time;
+	double m_worstTime;
+
+public:
+	SCA_LogicCost()
+		:m_calls(0),
+		m_time(0.0),
+		m_worstTime(0.0)
+	{
+	}
+
+	inline void AddCall(double time)
+	{
+		++m_calls;
+		m_time += time;
+		m_worstTime = std::max(m_worstTime, time);
+	}
+
+	inline void Reset()
+	{
+		m_calls = 0;
+		m_time = 0.0;
+		m_worstTime = 0.0;
+	}
+
+	inline unsigned int GetCalls() const
+	{
+		return m_calls;
+	}
+
+	inline double GetTime() const
+	{
+		return m_time;
+	}
+
+	inline double GetWorstTime() const
+	{
+		return m_worstTime;
+	}
+};
+
+/** Add the time spent in its scope to a cost.
+ * Nothing is measured for a null cost, which is passed when the costs are not collected.
+ */
+class SCA_LogicCostScope
+{
+private:
+	SCA_LogicCost *m_cost;
+	int64_t m_begin;
+
+public:
+	explicit SCA_LogicCostScope(SCA_LogicCost *cost)
+		:m_cost(cost)
+	{
+		if (m_cost) {
+			m_begin = CM_Profiler::GetTime();
+		}
+	}
+
+	~SCA_LogicCostScope()
+	{
+		if (m_cost) {
+			m_cost->AddCall(double(CM_Profiler::GetTime() - m_begin) * 1.0e-9);
+		}
+	}
+};
+
+#endif  // __SCA_LOGICCOST_H__
@@ -37,10 +37,14 @@
 #include "SCA_IActuator.h"
 #include "SCA_EventManager.h"
 #include "SCA_PythonController.h"
+
+#include "CM_Profiler.h"
+
 #include <set>
 
 
 SCA_LogicManager::SCA_LogicManager()
+	:m_costProfile(false)
 {
 }
 
@@ -153,6 +157,16 @@ void SCA_LogicManager::RegisterToActuator(SCA_IController* controller,SCA_IActua
 
 
 
+void SCA_LogicManager::SetCostProfile(bool profile)
+{
+	m_costProfile = profile;
+}
+
+bool SCA_LogicManager::GetCostProfile() const
+{
+	return m_costProfile;
+}
+
 void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 {
 	for (std::unique_ptr<SCA_EventManager>& mgr : m_eventmanagers) {
@@ -167,6 +181,12 @@ void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 			contr != nullptr;
 			contr = (SCA_IController*)obj->QRemove())
 		{
+			CM_ProfileScope profileScope("controller");
+			if (profileScope.IsActive()) {
+				profileScope.SetName(contr->GetParent()->GetName(), contr->GetName());
+			}
+			SCA_LogicCostScope costScope(m_costProfile ? &contr->GetCost() : nullptr);
+
 			contr->Trigger(this);
 			contr->ClrJustActivated();
 		}
@@ -193,6 +213,13 @@ void SCA_LogicManager::UpdateFrame(double curtime)
 			SCA_IActuator* actua = *ia;
 			// increment first to allow removal of inactive actuators.
 			++ia;
+
+			CM_ProfileScope profileScope("actuator");
+			if (profileScope.IsActive()) {
+				profileScope.SetName(actua->GetParent()->GetName(), actua->GetName());
+			}
+			SCA_LogicCostScope costScope(m_costProfile ? &actua->GetCost() : nullptr);
+
 			if (!actua->Update(curtime))
 			{
 				// this actuator is not active anymore, remove
@@ -84,6 +84,10 @@ class SCA_LogicManager
 
 	std::map<std::string, void *>		m_map_gamemeshname_to_blendobj;
 	std::map<void *, EXP_Value *>			m_map_blendobj_to_gameobj;
+
+	/// Measure the cost of the logic bricks.
+	bool m_costProfile;
+
 public:
 	SCA_LogicManager();
 	virtual ~SCA_LogicManager();
@@ -95,6 +99,9 @@ public:
 	void	RegisterToActuator(SCA_IController* controller,
 							   class SCA_IActuator* actuator);
 	
+	void SetCostProfile(bool profile);
+	bool GetCostProfile() const;
+
 	void	BeginFrame(double curtime, double fixedtime);
 	void	UpdateFrame(double curtime);
 	void	EndFrame();
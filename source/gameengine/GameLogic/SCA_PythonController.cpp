@@ -47,6 +47,7 @@ extern "C" {
 }
 
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 
 // initialize static member variables
 SCA_PythonController* SCA_PythonController::m_sCurrentController = nullptr;
@@ -339,6 +340,8 @@ void SCA_PythonController::Trigger(SCA_LogicManager* logicmgr)
 
 	PyObject *excdict=		nullptr;
 	PyObject *resultobj=	nullptr;
+
+	CM_ProfileScope profileScope("python", m_scriptName);
 	
 	switch (m_mode) {
 		case SCA_PYEXEC_SCRIPT:
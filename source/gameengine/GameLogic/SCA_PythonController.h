@@ -84,6 +84,7 @@ class SCA_PythonController : public SCA_IController
   
 	void	SetScriptText(const std::string& text);
 	void	SetScriptName(const std::string& name);
+	const std::string& GetScriptName() const { return m_scriptName; }
 	void	SetDebug(bool debug) { m_debug = debug; }
 	void	AddTriggeredSensor(class SCA_ISensor* sensor)
 		{ m_triggeredSensors.push_back(sensor); }
@@ -50,13 +50,17 @@ GPG_Canvas::GPG_Canvas(RAS_Rasterizer *rasty, GHOST_IWindow *window)
 	m_width(0),
 	m_height(0)
 {
+	// Without window the canvas is only sized by Resize and never rendered.
+	if (!m_window) {
+		m_viewport[0] = m_viewport[1] = m_viewport[2] = m_viewport[3] = 0;
+		return;
+	}
+
 	m_rasterizer->GetViewport(m_viewport);
 
-	if (m_window) {
-		GHOST_Rect bnds;
-		m_window->getClientBounds(bnds);
-		this->Resize(bnds.getWidth(), bnds.getHeight());
-	}
+	GHOST_Rect bnds;
+	m_window->getClientBounds(bnds);
+	this->Resize(bnds.getWidth(), bnds.getHeight());
 }
 
 GPG_Canvas::~GPG_Canvas()
@@ -227,6 +231,12 @@ void GPG_Canvas::GetDisplayDimensions(int &width, int &height)
 	unsigned int uiheight;
 
 	GHOST_ISystem *system = GHOST_ISystem::getSystem();
+	if (!system) {
+		width = m_width;
+		height = m_height;
+		return;
+	}
+
 	system->getMainDisplayDimensions(uiwidth, uiheight);
 
 	width = uiwidth;
@@ -235,6 +245,11 @@ void GPG_Canvas::GetDisplayDimensions(int &width, int &height)
 
 void GPG_Canvas::ResizeWindow(int width, int height)
 {
+	if (!m_window) {
+		Resize(width, height);
+		return;
+	}
+
 	if (m_window->getState() == GHOST_kWindowStateFullScreen) {
 		GHOST_ISystem *system = GHOST_ISystem::getSystem();
 		GHOST_DisplaySetting setting;
@@ -254,6 +269,10 @@ void GPG_Canvas::ResizeWindow(int width, int height)
 
 void GPG_Canvas::SetFullScreen(bool enable)
 {
+	if (!m_window) {
+		return;
+	}
+
 	if (enable) {
 		m_window->setState(GHOST_kWindowStateFullScreen);
 	}
@@ -264,11 +283,17 @@ void GPG_Canvas::SetFullScreen(bool enable)
 
 bool GPG_Canvas::GetFullScreen()
 {
-	return (m_window->getState() == GHOST_kWindowStateFullScreen);
+	return (m_window && m_window->getState() == GHOST_kWindowStateFullScreen);
 }
 
 void GPG_Canvas::ConvertMousePosition(int x, int y, int &r_x, int &r_y, bool UNUSED(screen))
 {
+	if (!m_window) {
+		r_x = x;
+		r_y = y;
+		return;
+	}
+
 	int _x;
 	int _y;
 	m_window->screenToClient(x, y, _x, _y);
@@ -126,6 +126,7 @@ extern "C"
 #include <boost/algorithm/string.hpp>
 
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 
 const int kMinWindowWidth = 100;
 const int kMinWindowHeight = 100;
@@ -443,8 +444,8 @@ static void usage(const std::string& program, bool isBlenderPlayer)
 	}
 	CM_Message(std::endl)
 	CM_Message("usage:   " << program << " [--options] " << example_filename << std::endl);
-	CM_Message("Available options are: [-w [w h l t]] [-f [fw fh fb ff]] " << consoleoption << "[-g gamengineoptions] "
-		<< "[-s stereomode] [-m aasamples]");
+	CM_Message("Available options are: [-w [w h l t]] [-f [fw fh fb ff]] [-b] " << consoleoption << "[-g gamengineoptions] "
+		<< "[-s stereomode] [-m aasamples] [-t tracefile]");
 	CM_Message("Optional parameters must be passed in order.");
 	CM_Message("Default values are set in the blend file." << std::endl);
 	CM_Message("  -h: Prints this command summary" << std::endl);
@@ -465,6 +466,9 @@ static void usage(const std::string& program, bool isBlenderPlayer)
 	CM_Message("       ff = fullscreen mode frequency      (default unless set in the blend file: 60)");
 	CM_Message("       Note: To define 'fw'' or 'fh'', both must be used.");
 	CM_Message("       Example: -f  or  -f 1024 768  or  -f 0 0 16  or  -f 1024 728 16 30" << std::endl);
+	CM_Message("  -b: run headless, without window, input events or render");
+	CM_Message("       only the logic, physics, animations and python are updated");
+	CM_Message("       Example: -b -g unlimited_ticrate = 1 -g max_frames = 1000" << std::endl);
 	CM_Message("  -s: start player in stereoscopy mode (requires 3D capable hardware)");
 	CM_Message("       stereomode: nostereo         (default unless stereo is set in the blend file)");
 	CM_Message("                   anaglyph         (Red-Blue glasses)");
@@ -498,8 +502,20 @@ static void usage(const std::string& program, bool isBlenderPlayer)
 	CM_Message("       show_armatures                 0         Show debug armatures");
 	CM_Message("       show_camera_frustum            0         Show debug camera frustum volume");
 	CM_Message("       show_shadow_frustum            0         Show debug light shadow frustum volume");
+	CM_Message("       parallel_scenes                0         Update scene graph and physics of the scenes in parallel");
+	CM_Message("       parallel_scenegraph            0         Update independent objects hierarchies in parallel");
+	CM_Message("       parallel_physics               0         Synchronize physics objects in parallel");
+	CM_Message("       profile_logic                  0         Measure the cost of logic bricks and components");
+	CM_Message("       parallel_shadows               0         Compute the shadow casters of the lights in parallel");
+	CM_Message("       cache_shadows                  0         Don't render again the shadows of unchanged lights and casters");
+	CM_Message("       ticrate                        file      Number of logic tics per second");
+	CM_Message("       unlimited_ticrate              0         Proceed one logic tic per frame without waiting the real time");
+	CM_Message("       max_frames                     0         Exit after this number of frames, 0 to never exit");
 	CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings" << std::endl);
 	CM_Message("  -p: override python main loop script");
+	CM_Message("  -t: write the profiled events of the engine, logic bricks, physics, animations and render passes");
+	CM_Message("       to a Chrome trace file readable by chrome://tracing or Perfetto");
+	CM_Message("       Example: -t trace.json" << std::endl);
 	CM_Message(std::endl);
 	CM_Message("  - : all arguments after this are ignored, allowing python to access them from sys.argv");
 	CM_Message(std::endl);
@@ -668,8 +684,10 @@ int main(
 	int validArguments=0;
 	bool samplesParFound = false;
 	std::string pythonControllerFile;
+	std::string profileTraceFile;
 	GHOST_TUns16 aasamples = 0;
 	int alphaBackground = 0;
+	bool headless = false;
 	
 #ifdef WIN32
 	char **argv;
@@ -1069,6 +1087,12 @@ int main(
 				}
 				break;
 			}
+			case 'b': // run headless
+			{
+				++i;
+				headless = true;
+				break;
+			}
 			case 'a':   // allow window to blend with display background
 			{
 				i++;
@@ -1081,6 +1105,18 @@ int main(
 				pythonControllerFile = argv[i++];
 				break;
 			}
+			case 't': // write a trace of the profiled events
+			{
+				++i;
+				if ((i + 1) <= validArguments) {
+					profileTraceFile = argv[i++];
+				}
+				else {
+					error = true;
+					CM_Error("no argument supplied for -t");
+				}
+				break;
+			}
 			default:  //not recognized
 			{
 				CM_Warning("unknown argument: " << argv[i++]);
@@ -1106,22 +1142,29 @@ int main(
 		return 0;
 	}
 
+	if (!profileTraceFile.empty()) {
+		CM_Profiler::Enable();
+		CM_Profiler::SetThreadName("Main");
+	}
+
 #ifdef WIN32
 	if (scr_saver_mode != SCREEN_SAVER_MODE_CONFIGURATION)
 #endif
 	{
-		// Create the system
-		if (GHOST_ISystem::createSystem() == GHOST_kSuccess) {
-			GHOST_ISystem* system = GHOST_ISystem::getSystem();
-			BLI_assert(system);
-			
-			if (!fullScreenWidth || !fullScreenHeight)
-				system->getMainDisplayDimensions(fullScreenWidth, fullScreenHeight);
-			// process first batch of events. If the user
-			// drops a file on top off the blenderplayer icon, we
-			// receive an event with the filename
-			
-			system->processEvents(0);
+		// Create the system, a headless game runs without any.
+		if (headless || GHOST_ISystem::createSystem() == GHOST_kSuccess) {
+			GHOST_ISystem* system = headless ? nullptr : GHOST_ISystem::getSystem();
+			BLI_assert(system || headless);
+
+			if (system) {
+				if (!fullScreenWidth || !fullScreenHeight)
+					system->getMainDisplayDimensions(fullScreenWidth, fullScreenHeight);
+				// process first batch of events. If the user
+				// drops a file on top off the blenderplayer icon, we
+				// receive an event with the filename
+
+				system->processEvents(0);
+			}
 
 #ifdef WITH_PYTHON
 			// Initialize python and the global dictionary.
@@ -1206,7 +1249,7 @@ int main(
 						/* Setting options according to the blend file if not overriden in the command line */
 #ifdef WIN32
 #if !defined(DEBUG)
-						if (closeConsole) {
+						if (closeConsole && system) {
 							system->toggleConsole(0); // Close a console window
 						}
 #endif // !defined(DEBUG)
@@ -1298,7 +1341,11 @@ int main(
 							aasamples = scene->gm.aasamples;
 
 						BLI_strncpy(pathname, maggie->name, sizeof(pathname));
-						if (firstTimeRunning) {
+						// A headless game never creates a window nor initializes the GPU.
+						if (firstTimeRunning && headless) {
+							firstTimeRunning = false;
+						}
+						else if (firstTimeRunning) {
 							firstTimeRunning = false;
 
 							if (fullScreen) {
@@ -1402,9 +1449,15 @@ int main(
 						G.main = nullptr;
 					}
 				} while (!quitGame(exitcode));
+
+				if (!profileTraceFile.empty()) {
+					CM_Profiler::WriteChromeTrace(profileTraceFile);
+				}
 			}
 
-			GPU_exit();
+			if (!headless) {
+				GPU_exit();
+			}
 
 #ifdef WITH_PYTHON
 			PyDict_Clear(globalDict);
@@ -1420,7 +1473,9 @@ int main(
 			}
 
 			// Dispose the system
-			GHOST_ISystem::disposeSystem();
+			if (system) {
+				GHOST_ISystem::disposeSystem();
+			}
 		}
 		else {
 			error = true;
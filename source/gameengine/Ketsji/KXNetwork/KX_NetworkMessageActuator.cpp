@@ -47,6 +47,8 @@ KX_NetworkMessageActuator::KX_NetworkMessageActuator(
 	m_networkscene(networkscene),
 	m_toPropName(toPropName),
 	m_subject(subject),
+	m_toId(networkscene->GetId(toPropName)),
+	m_subjectId(networkscene->GetId(subject)),
 	m_bPropBody(bodyType),
 	m_body(body)
 {
@@ -69,16 +71,16 @@ bool KX_NetworkMessageActuator::Update()
 	// ACT_MESG_PROP in DNA_actuator_types.h
 	if (m_bPropBody) {
 		m_networkscene->SendMessage(
-		    m_toPropName,
+		    m_toId,
 		    GetParent(),
-		    m_subject,
+		    m_subjectId,
 		    GetParent()->GetPropertyText(m_body));
 	}
 	else {
 		m_networkscene->SendMessage(
-		    m_toPropName,
+		    m_toId,
 		    GetParent(),
-		    m_subject,
+		    m_subjectId,
 		    m_body);
 	}
 	return false;
@@ -126,11 +128,19 @@ PyMethodDef KX_NetworkMessageActuator::Methods[] = {
 };
 
 PyAttributeDef KX_NetworkMessageActuator::Attributes[] = {
-	EXP_PYATTRIBUTE_STRING_RW("propName", 0, MAX_PROP_NAME, false, KX_NetworkMessageActuator, m_toPropName),
-	EXP_PYATTRIBUTE_STRING_RW("subject", 0, 100, false, KX_NetworkMessageActuator, m_subject),
+	EXP_PYATTRIBUTE_STRING_RW_CHECK("propName", 0, MAX_PROP_NAME, false, KX_NetworkMessageActuator, m_toPropName, pyattr_check_message_ids),
+	EXP_PYATTRIBUTE_STRING_RW_CHECK("subject", 0, 100, false, KX_NetworkMessageActuator, m_subject, pyattr_check_message_ids),
 	EXP_PYATTRIBUTE_BOOL_RW("usePropBody", KX_NetworkMessageActuator, m_bPropBody),
 	EXP_PYATTRIBUTE_STRING_RW("body", 0, 16384, false, KX_NetworkMessageActuator, m_body),
 	EXP_PYATTRIBUTE_NULL //Sentinel
 };
 
+int KX_NetworkMessageActuator::pyattr_check_message_ids(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+	KX_NetworkMessageActuator *self = static_cast<KX_NetworkMessageActuator *>(self_v);
+	self->m_toId = self->m_networkscene->GetId(self->m_toPropName);
+	self->m_subjectId = self->m_networkscene->GetId(self->m_subject);
+	return 0;
+}
+
 #endif // WITH_PYTHON
@@ -35,6 +35,7 @@
 
 #include <string>
 #include "SCA_IActuator.h"
+#include "KX_NetworkMessageManager.h"
 
 class KX_NetworkMessageActuator : public SCA_IActuator
 {
@@ -43,6 +44,9 @@ class KX_NetworkMessageActuator : public SCA_IActuator
 	class KX_NetworkMessageScene *m_networkscene;  // needed for replication
 	std::string m_toPropName;
 	std::string m_subject;
+	/// Interned receiver name and subject.
+	KX_NetworkMessageManager::Id m_toId;
+	KX_NetworkMessageManager::Id m_subjectId;
 	bool m_bPropBody;
 	std::string m_body;
 
@@ -62,6 +66,10 @@ public:
 	{
 		m_networkscene = val;
 	};
+
+#ifdef WITH_PYTHON
+	static int pyattr_check_message_ids(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+#endif  // WITH_PYTHON
 };
 
 #endif  /* __KX_NETWORKMESSAGEACTUATOR_H__ */
@@ -31,54 +31,175 @@
  */
 
 #include "KX_NetworkMessageManager.h"
-#include <iostream>
+
+#include <algorithm>
+
+static unsigned long long messageRangeKey(KX_NetworkMessageManager::Id to, KX_NetworkMessageManager::Id subject)
+{
+	return (((unsigned long long)to) << 32) | subject;
+}
 
 KX_NetworkMessageManager::KX_NetworkMessageManager()
 	:m_currentList(0)
 {
+	// The empty string is used for messages without receiver or subject.
+	GetId("");
 }
 
 KX_NetworkMessageManager::~KX_NetworkMessageManager()
 {
-	ClearMessages();
 }
 
-void KX_NetworkMessageManager::AddMessage(KX_NetworkMessageManager::Message message)
+KX_NetworkMessageManager::Id KX_NetworkMessageManager::InternId(const std::string& name, bool persistent)
 {
-	// Put the new message in map for the given receiver and subject.
-	m_messages[m_currentList][message.to][message.subject].push_back(message);
+	const auto it = m_ids.find(name);
+	if (it != m_ids.end()) {
+		if (persistent) {
+			m_persistentIds[it->second] = true;
+		}
+		return it->second;
+	}
+
+	Id id;
+	if (m_freeIds.empty()) {
+		id = m_names.size();
+		m_names.push_back(name);
+		m_persistentIds.push_back(persistent);
+	}
+	else {
+		id = m_freeIds.back();
+		m_freeIds.pop_back();
+		m_names[id] = name;
+		m_persistentIds[id] = persistent;
+	}
+
+	if (!persistent) {
+		m_messageIds.push_back(id);
+	}
+	m_ids.emplace(name, id);
+
+	return id;
 }
 
-const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageManager::GetMessages(std::string to, std::string subject)
+KX_NetworkMessageManager::Id KX_NetworkMessageManager::GetId(const std::string& name)
 {
-	std::vector<KX_NetworkMessageManager::Message> messages;
-
-	// look at messages without receiver.
-	std::map<std::string, std::vector<Message> >& messagesNoReceiver = m_messages[1 - m_currentList][""];
-	std::map<std::string, std::vector<Message> >& messagesReceiver = m_messages[1 - m_currentList][to];
-	if (subject.empty()) {
-		// Add all message without receiver and subject.
-		for (const auto& pair : messagesNoReceiver) {
-			messages.insert(messages.end(), pair.second.begin(), pair.second.end());
-		}
-		// Add all message with the given receiver and no subject.
-		for (const auto& pair : messagesReceiver) {
-			messages.insert(messages.end(), pair.second.begin(), pair.second.end());
-		}
+	return InternId(name, true);
+}
+
+KX_NetworkMessageManager::Id KX_NetworkMessageManager::GetMessageId(const std::string& name)
+{
+	return InternId(name, false);
+}
+
+KX_NetworkMessageManager::Id KX_NetworkMessageManager::FindId(const std::string& name) const
+{
+	const auto it = m_ids.find(name);
+	if (it == m_ids.end()) {
+		return INVALID_ID;
 	}
-	else {
-		std::vector<KX_NetworkMessageManager::Message>& messagesNoReceiverSubject = messagesNoReceiver[subject];
-		messages.insert(messages.end(), messagesNoReceiverSubject.begin(), messagesNoReceiverSubject.end());
-		std::vector<KX_NetworkMessageManager::Message>& messagesReceiverSubject = messagesReceiver[subject];
-		messages.insert(messages.end(), messagesReceiverSubject.begin(), messagesReceiverSubject.end());
+	return it->second;
+}
+
+const std::string& KX_NetworkMessageManager::GetName(Id id) const
+{
+	return m_names[id];
+}
+
+void KX_NetworkMessageManager::AddMessage(Message&& message)
+{
+	m_messages[m_currentList].push_back(std::move(message));
+}
+
+KX_NetworkMessageManager::MessageRange KX_NetworkMessageManager::GetRange(Id to, Id subject) const
+{
+	const auto it = m_ranges.find(messageRangeKey(to, subject));
+	if (it == m_ranges.end()) {
+		return MessageRange();
+	}
+
+	const Message *messages = m_messages[1 - m_currentList].data();
+	return MessageRange(messages + it->second.first, messages + it->second.second);
+}
+
+KX_NetworkMessageManager::MessageRanges KX_NetworkMessageManager::GetMessages(Id to, Id subject) const
+{
+	MessageRanges ranges;
+	if (subject == INVALID_ID) {
+		// No message was ever sent with this subject.
+		return ranges;
+	}
+
+	// An empty subject selects all the subjects of the receiver.
+	const Id rangeSubject = (subject == NO_ID) ? INVALID_ID : subject;
+	ranges.noReceiver = GetRange(NO_ID, rangeSubject);
+	if (to != INVALID_ID) {
+		ranges.receiver = GetRange(to, rangeSubject);
+	}
+
+	return ranges;
+}
+
+void KX_NetworkMessageManager::FreeMessageIds(const std::vector<Message>& messages)
+{
+	if (m_messageIds.empty()) {
+		return;
 	}
 
-	return messages;
+	m_usedIds.assign(m_names.size(), false);
+	for (const Message& message : messages) {
+		m_usedIds[message.to] = true;
+		m_usedIds[message.subject] = true;
+	}
+
+	unsigned int numMessageIds = 0;
+	for (Id id : m_messageIds) {
+		// The id was requested by GetId since.
+		if (m_persistentIds[id]) {
+			continue;
+		}
+
+		if (m_usedIds[id]) {
+			m_messageIds[numMessageIds++] = id;
+		}
+		else {
+			m_ids.erase(m_names[id]);
+			m_names[id].clear();
+			m_freeIds.push_back(id);
+		}
+	}
+	m_messageIds.resize(numMessageIds);
 }
 
 void KX_NetworkMessageManager::ClearMessages()
 {
 	// Clear previous list.
 	m_messages[1 - m_currentList].clear();
+	m_ranges.clear();
+
+	std::vector<Message>& messages = m_messages[m_currentList];
+
+	// Only the messages of the frame can use the ids of the previous messages.
+	FreeMessageIds(messages);
+
+	/* Group the messages of the frame by receiver and subject, keeping the sending order,
+	 * to expose the messages of a sensor as contiguous ranges. */
+	std::stable_sort(messages.begin(), messages.end(), [](const Message& m1, const Message& m2) {
+		return (m1.to < m2.to) || (m1.to == m2.to && m1.subject < m2.subject);
+	});
+
+	for (unsigned int i = 0, size = messages.size(); i < size; ) {
+		const Id to = messages[i].to;
+		const unsigned int receiverBegin = i;
+		while (i < size && messages[i].to == to) {
+			const Id subject = messages[i].subject;
+			const unsigned int subjectBegin = i;
+			while (i < size && messages[i].to == to && messages[i].subject == subject) {
+				++i;
+			}
+			m_ranges.emplace(messageRangeKey(to, subject), std::make_pair(subjectBegin, i));
+		}
+		m_ranges.emplace(messageRangeKey(to, INVALID_ID), std::make_pair(receiverBegin, i));
+	}
+
 	m_currentList = 1 - m_currentList;
 }
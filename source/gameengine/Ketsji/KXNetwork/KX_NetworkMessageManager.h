@@ -36,51 +36,146 @@ conflicts with KX_NetworkMessageManager::SendMessage */
 #endif
 
 #include <string>
-#include <map>
 #include <vector>
+#include <unordered_map>
 
 class SCA_IObject;
 
 class KX_NetworkMessageManager
 {
 public:
+	/// Interned receiver name or subject, the empty string is always NO_ID.
+	using Id = unsigned int;
+
+	enum : Id {
+		NO_ID = 0,
+		/// Returned by FindId for a string never used by a message.
+		INVALID_ID = (Id)-1
+	};
+
 	struct Message
 	{
 		/// Receiver object(s) name.
-		std::string to;
+		Id to;
 		/// Sender game object.
 		SCA_IObject *from;
 		/// Message subject, used as filter.
-		std::string subject;
+		Id subject;
 		/// Message body.
 		std::string body;
 	};
 
+	/// Contiguous range of messages stored by the manager, valid until the next call to ClearMessages.
+	class MessageRange
+	{
+	private:
+		const Message *m_begin;
+		const Message *m_end;
+
+	public:
+		MessageRange()
+			:m_begin(nullptr),
+			m_end(nullptr)
+		{
+		}
+
+		MessageRange(const Message *begin, const Message *end)
+			:m_begin(begin),
+			m_end(end)
+		{
+		}
+
+		const Message *begin() const
+		{
+			return m_begin;
+		}
+
+		const Message *end() const
+		{
+			return m_end;
+		}
+
+		unsigned int size() const
+		{
+			return m_end - m_begin;
+		}
+
+		bool empty() const
+		{
+			return m_begin == m_end;
+		}
+	};
+
+	/// Messages found for a receiver, the messages without receiver come first.
+	struct MessageRanges
+	{
+		MessageRange noReceiver;
+		MessageRange receiver;
+
+		unsigned int size() const
+		{
+			return noReceiver.size() + receiver.size();
+		}
+	};
+
 private:
-	/** List of all messages, filtered by receiver object(s) name and subject name.
+	/** List of all messages sorted by receiver and subject once the frame is over.
 	 * We use two lists, one handle sended message in the current frame and the other
 	 * is used for handle message sended in the last frame for sensors.
+	 * The lists are cleared but never freed to reuse their memory the next frames.
 	 */
-	std::map<std::string, std::map<std::string, std::vector<Message> > > m_messages[2];
+	std::vector<Message> m_messages[2];
+
+	/// Index range in the last frame list of a receiver and subject pair or all the subjects of a receiver.
+	std::unordered_map<unsigned long long, std::pair<unsigned int, unsigned int> > m_ranges;
+
+	/// Interned strings and their ids.
+	std::unordered_map<std::string, Id> m_ids;
+	std::vector<std::string> m_names;
+	/// True for the ids requested by GetId, these ids are never freed.
+	std::vector<bool> m_persistentIds;
+	/// Ids only requested by GetMessageId, freed once no message uses them.
+	std::vector<Id> m_messageIds;
+	/// Freed ids reused by the next interned strings.
+	std::vector<Id> m_freeIds;
+	/// Ids used by the messages of the frame, kept to reuse its memory.
+	std::vector<bool> m_usedIds;
 
 	/** Since we use two list for the current and last frame we have to switch of
 	 * current message list each frame. This value is only 0 or 1.
 	 */
 	unsigned short m_currentList;
 
+	MessageRange GetRange(Id to, Id subject) const;
+	Id InternId(const std::string& name, bool persistent);
+	/// Free the message ids not used by the given messages.
+	void FreeMessageIds(const std::vector<Message>& messages);
+
 public:
 	KX_NetworkMessageManager();
 	virtual ~KX_NetworkMessageManager();
 
+	/** Return the id of a receiver name or subject, create it if it doesn't exist.
+	 * The id is never freed, it is meant to be cached by the logic bricks.
+	 */
+	Id GetId(const std::string& name);
+	/** Return the id of a receiver name or subject for a single message, create
+	 * it if it doesn't exist. The id is freed once no message uses it.
+	 */
+	Id GetMessageId(const std::string& name);
+	/// Return the id of a receiver name or subject or INVALID_ID if it doesn't exist.
+	Id FindId(const std::string& name) const;
+	const std::string& GetName(Id id) const;
+
 	/** Add a message in the next message list.
 	 * \param message The given message to add.
 	 */
-	void AddMessage(Message message);
-	/** Get all messages for a given receiver object name and message subject.
-	 * \param to The object(s) name.
-	 * \param subject The message subject/filter.
+	void AddMessage(Message&& message);
+	/** Get all messages of the last frame for a given receiver object name and message subject.
+	 * \param to The object(s) name id.
+	 * \param subject The message subject/filter id, NO_ID for all subjects.
 	 */
-	const std::vector<Message> GetMessages(std::string to, std::string subject);
+	MessageRanges GetMessages(Id to, Id subject) const;
 
 	/// Clear all messages
 	void ClearMessages();
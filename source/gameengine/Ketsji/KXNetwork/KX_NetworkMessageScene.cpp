@@ -41,7 +41,13 @@ KX_NetworkMessageScene::~KX_NetworkMessageScene()
 {
 }
 
-void KX_NetworkMessageScene::SendMessage(std::string to, SCA_IObject *from, std::string subject, std::string body)
+void KX_NetworkMessageScene::SendMessage(const std::string& to, SCA_IObject *from, const std::string& subject, const std::string& body)
+{
+	SendMessage(m_messageManager->GetMessageId(to), from, m_messageManager->GetMessageId(subject), body);
+}
+
+void KX_NetworkMessageScene::SendMessage(KX_NetworkMessageManager::Id to, SCA_IObject *from, KX_NetworkMessageManager::Id subject,
+		const std::string& body)
 {
 	KX_NetworkMessageManager::Message message;
 	message.to = to;
@@ -49,11 +55,21 @@ void KX_NetworkMessageScene::SendMessage(std::string to, SCA_IObject *from, std:
 	message.subject = subject;
 	message.body = body;
 
-	// Put the new message in map for the given receiver and subject.
-	m_messageManager->AddMessage(message);
+	// Put the new message in the list of the current frame.
+	m_messageManager->AddMessage(std::move(message));
+}
+
+KX_NetworkMessageManager::Id KX_NetworkMessageScene::GetId(const std::string& name)
+{
+	return m_messageManager->GetId(name);
+}
+
+const std::string& KX_NetworkMessageScene::GetName(KX_NetworkMessageManager::Id id) const
+{
+	return m_messageManager->GetName(id);
 }
 
-const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageScene::FindMessages(std::string to, std::string subject)
+KX_NetworkMessageManager::MessageRanges KX_NetworkMessageScene::FindMessages(KX_NetworkMessageManager::Id to, KX_NetworkMessageManager::Id subject) const
 {
 	return m_messageManager->GetMessages(to, subject);
 }
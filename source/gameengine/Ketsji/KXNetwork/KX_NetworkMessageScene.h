@@ -61,13 +61,19 @@ public:
 	 * \param subject The message subject, used as filter for receiver object(s).
 	 * \param message The body of the message.
 	 */
-	void SendMessage(std::string to, SCA_IObject *from, std::string subject, std::string body);
+	void SendMessage(const std::string& to, SCA_IObject *from, const std::string& subject, const std::string& body);
+	/// Send a message using the interned receiver name and subject.
+	void SendMessage(KX_NetworkMessageManager::Id to, SCA_IObject *from, KX_NetworkMessageManager::Id subject, const std::string& body);
+
+	/// Return the id of a receiver name or subject, see KX_NetworkMessageManager::GetId.
+	KX_NetworkMessageManager::Id GetId(const std::string& name);
+	const std::string& GetName(KX_NetworkMessageManager::Id id) const;
 
 	/** Get all messages for a given receiver object name and message subject.
-	 * \param to The object(s) name.
-	 * \param subject The message subject/filter.
+	 * \param to The object(s) name id.
+	 * \param subject The message subject/filter id.
 	 */
-	const std::vector<KX_NetworkMessageManager::Message> FindMessages(std::string to, std::string subject);
+	KX_NetworkMessageManager::MessageRanges FindMessages(KX_NetworkMessageManager::Id to, KX_NetworkMessageManager::Id subject) const;
 };
 
 #endif // __KX_NETWORKMESSAGESCENE_H__
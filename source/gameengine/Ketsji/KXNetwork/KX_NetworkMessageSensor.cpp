@@ -52,6 +52,9 @@ KX_NetworkMessageSensor::KX_NetworkMessageSensor(
 	:SCA_ISensor(gameobj, eventmgr),
 	m_NetworkScene(NetworkScene),
 	m_subject(subject),
+	m_subjectId(NetworkScene->GetId(subject)),
+	m_toName(gameobj->GetName()),
+	m_toId(NetworkScene->GetId(m_toName)),
 	m_frame_message_count(0),
 	m_BodyList(nullptr),
 	m_SubjectList(nullptr)
@@ -100,15 +103,18 @@ bool KX_NetworkMessageSensor::Evaluate()
 		m_SubjectList = nullptr;
 	}
 
-	std::string toname = GetParent()->GetName();
-	std::string& subject = this->m_subject;
+	// The owner can be renamed from python, intern its name only when it changes.
+	const std::string toName = GetParent()->GetName();
+	if (toName != m_toName) {
+		m_toName = toName;
+		m_toId = m_NetworkScene->GetId(m_toName);
+	}
 
-	const std::vector<KX_NetworkMessageManager::Message> messages =
-	    m_NetworkScene->FindMessages(toname, subject);
+	const KX_NetworkMessageManager::MessageRanges messages = m_NetworkScene->FindMessages(m_toId, m_subjectId);
 
 	m_frame_message_count = messages.size();
 
-	if (!messages.empty()) {
+	if (m_frame_message_count > 0) {
 #ifdef NAN_NET_DEBUG
 		std::cout << "KX_NetworkMessageSensor found one or more messages" << std::endl;
 #endif
@@ -117,20 +123,19 @@ bool KX_NetworkMessageSensor::Evaluate()
 		m_SubjectList = new EXP_ListValue<EXP_StringValue>();
 	}
 
-	std::vector<KX_NetworkMessageManager::Message>::const_iterator mesit;
-	for (mesit = messages.begin(); mesit != messages.end(); mesit++) {
-		// save the body
-		const std::string& body = (*mesit).body;
-		// save the subject
-		const std::string& messub = (*mesit).subject;
+	for (const KX_NetworkMessageManager::MessageRange& range : {messages.noReceiver, messages.receiver}) {
+		for (const KX_NetworkMessageManager::Message& message : range) {
+			// save the body
+			const std::string& body = message.body;
+			// save the subject
+			const std::string& messub = m_NetworkScene->GetName(message.subject);
 #ifdef NAN_NET_DEBUG
-		if (body) {
-			cout << "body [" << body << "]\n";
-		}
+			std::cout << "body [" << body << "]\n";
 #endif
-		m_BodyList->Add(new EXP_StringValue(body, "body"));
-		// Store Subject
-		m_SubjectList->Add(new EXP_StringValue(messub, "subject"));
+			m_BodyList->Add(new EXP_StringValue(body, "body"));
+			// Store Subject
+			m_SubjectList->Add(new EXP_StringValue(messub, "subject"));
+		}
 	}
 
 	result = (WasUp != m_IsUp);
@@ -186,7 +191,7 @@ PyMethodDef KX_NetworkMessageSensor::Methods[] = {
 };
 
 PyAttributeDef KX_NetworkMessageSensor::Attributes[] = {
-	EXP_PYATTRIBUTE_STRING_RW("subject", 0, 100, false, KX_NetworkMessageSensor, m_subject),
+	EXP_PYATTRIBUTE_STRING_RW_CHECK("subject", 0, 100, false, KX_NetworkMessageSensor, m_subject, pyattr_check_subject),
 	EXP_PYATTRIBUTE_INT_RO("frameMessageCount", KX_NetworkMessageSensor, m_frame_message_count),
 	EXP_PYATTRIBUTE_RO_FUNCTION("bodies", KX_NetworkMessageSensor, pyattr_get_bodies),
 	EXP_PYATTRIBUTE_RO_FUNCTION("subjects", KX_NetworkMessageSensor, pyattr_get_subjects),
@@ -215,4 +220,11 @@ PyObject *KX_NetworkMessageSensor::pyattr_get_subjects(EXP_PyObjectPlus *self_v,
 	}
 }
 
+int KX_NetworkMessageSensor::pyattr_check_subject(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+	KX_NetworkMessageSensor *self = static_cast<KX_NetworkMessageSensor *>(self_v);
+	self->m_subjectId = self->m_NetworkScene->GetId(self->m_subject);
+	return 0;
+}
+
 #endif // WITH_PYTHON
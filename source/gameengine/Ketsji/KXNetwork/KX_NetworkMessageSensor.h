@@ -33,6 +33,7 @@
 #define __KX_NETWORKMESSAGESENSOR_H__
 
 #include "SCA_ISensor.h"
+#include "KX_NetworkMessageManager.h"
 
 class KX_NetworkMessageScene;
 class EXP_StringValue;
@@ -47,6 +48,10 @@ class KX_NetworkMessageSensor : public SCA_ISensor
 
 	// The subject we filter on.
 	std::string m_subject;
+	KX_NetworkMessageManager::Id m_subjectId;
+	/// Name of the sensor owner, the receiver name of its messages, and its id.
+	std::string m_toName;
+	KX_NetworkMessageManager::Id m_toId;
 
 	// The number of messages caught since the last frame.
 	int m_frame_message_count;
@@ -84,6 +89,7 @@ public:
 	/* attributes */
 	static PyObject *pyattr_get_bodies(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
 	static PyObject *pyattr_get_subjects(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+	static int pyattr_check_subject(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
 
 #endif  /* WITH_PYTHON */
 };
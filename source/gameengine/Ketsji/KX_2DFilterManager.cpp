@@ -27,6 +27,10 @@
 #include "KX_2DFilterManager.h"
 #include "KX_2DFilter.h"
 #include "KX_2DFilterOffScreen.h"
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+
+#include "RAS_Rasterizer.h"
 
 #include "CM_Message.h"
 
@@ -120,6 +124,12 @@ EXP_PYMETHODDEF_DOC(KX_2DFilterManager, addFilter, " addFilter(index, type, frag
 		CM_PythonFunctionWarning("KX_2DFilterManager", "addFilter", "non-empty fragment program with non-custom filter type");
 	}
 
+	// The filter shaders need a render context.
+	if (KX_GetActiveEngine()->GetRasterizer()->IsHeadless()) {
+		PyErr_SetString(PyExc_RuntimeError, "filterManager.addFilter(index, type, fragmentProgram): KX_2DFilterManager, 2D filters are not available in headless mode");
+		return nullptr;
+	}
+
 	RAS_2DFilterData data;
 	data.filterPassIndex = index;
 	data.filterMode = type;
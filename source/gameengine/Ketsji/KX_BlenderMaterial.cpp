@@ -24,6 +24,8 @@
 
 #include "KX_BlenderMaterial.h"
 #include "KX_Scene.h"
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
 #include "KX_PyMath.h"
 
 #include "BL_Shader.h"
@@ -35,6 +37,8 @@
 #include "RAS_Rasterizer.h"
 #include "RAS_MeshUser.h"
 
+#include "CM_Message.h"
+
 #include "GPU_draw.h"
 #include "GPU_material.h" // for GPU_BLEND_SOLID
 
@@ -200,6 +204,11 @@ void KX_BlenderMaterial::ReloadMaterial()
 
 void KX_BlenderMaterial::InitTextures()
 {
+	// No GPU textures are created without render.
+	if (KX_GetActiveEngine()->GetRasterizer()->IsHeadless()) {
+		return;
+	}
+
 	// for each unique material...
 	int i;
 	for (i = 0; i < RAS_Texture::MaxUnits; i++) {
@@ -215,6 +224,11 @@ void KX_BlenderMaterial::InitScene(KX_Scene *scene)
 {
 	m_scene = scene;
 
+	// No shader is compiled without render.
+	if (KX_GetActiveEngine()->GetRasterizer()->IsHeadless()) {
+		return;
+	}
+
 	if (!m_blenderShader) {
 		m_blenderShader = new BL_BlenderShader(m_scene, m_material, m_lightLayer, this);
 	}
@@ -851,6 +865,12 @@ EXP_PYMETHODDEF_DOC(KX_BlenderMaterial, getShader, "getShader()")
 	// returns Py_None on error
 	// the calling script will need to check
 
+	// Custom shaders need a render context.
+	if (KX_GetActiveEngine()->GetRasterizer()->IsHeadless()) {
+		CM_PythonFunctionError("KX_BlenderMaterial", "getShader", "custom shaders are not available in headless mode");
+		Py_RETURN_NONE;
+	}
+
 	if (!m_shader) {
 		m_shader = new BL_Shader(this);
 	}
@@ -41,7 +41,7 @@ KX_CollisionEventManager::KX_CollisionEventManager(SCA_LogicManager *logicmgr, P
 	:SCA_EventManager(logicmgr, TOUCH_EVENTMGR),
 	m_physEnv(physEnv)
 {
-	m_physEnv->AddCollisionCallback(PHY_OBJECT_RESPONSE, KX_CollisionEventManager::newCollisionResponse, this);
+	m_physEnv->AddCollisionBatchCallback(KX_CollisionEventManager::newCollisionsResponse, this);
 	m_physEnv->AddCollisionCallback(PHY_SENSOR_RESPONSE, KX_CollisionEventManager::newCollisionResponse, this);
 	m_physEnv->AddCollisionCallback(PHY_BROADPH_RESPONSE, KX_CollisionEventManager::newBroadphaseResponse, this);
 }
@@ -59,7 +59,7 @@ void KX_CollisionEventManager::RemoveNewCollisions()
 bool KX_CollisionEventManager::NewHandleCollision(PHY_IPhysicsController *ctrl1, PHY_IPhysicsController *ctrl2,
 		const PHY_ICollData *coll_data, bool first)
 {
-	m_newCollisions.insert(NewCollision(ctrl1, ctrl2, coll_data, first));
+	m_newCollisions.push_back({ctrl1, ctrl2, coll_data, first});
 
 	return false;
 }
@@ -72,6 +72,12 @@ bool KX_CollisionEventManager::newCollisionResponse(void *client_data, PHY_IPhys
 	return false;
 }
 
+void KX_CollisionEventManager::newCollisionsResponse(void *client_data, const PHY_CollisionPair *pairs, unsigned int count)
+{
+	KX_CollisionEventManager *collisionmgr = (KX_CollisionEventManager *)client_data;
+	collisionmgr->m_newCollisions.insert(collisionmgr->m_newCollisions.end(), pairs, pairs + count);
+}
+
 bool KX_CollisionEventManager::newBroadphaseResponse(void *client_data, PHY_IPhysicsController *ctrl1,
 		PHY_IPhysicsController *ctrl2, const PHY_ICollData *coll_data, bool first)
 {
@@ -169,10 +175,10 @@ void KX_CollisionEventManager::NextFrame()
 		static_cast<KX_CollisionSensor *>(sensor)->SynchronizeTransform();
 	}
 
-	for (const NewCollision& collision : m_newCollisions) {
+	for (const PHY_CollisionPair& collision : m_newCollisions) {
 		// Controllers
-		PHY_IPhysicsController *ctrl1 = collision.first;
-		PHY_IPhysicsController *ctrl2 = collision.second;
+		PHY_IPhysicsController *ctrl1 = collision.ctrl1;
+		PHY_IPhysicsController *ctrl2 = collision.ctrl2;
 		// Sensor iterator
 		std::list<SCA_ISensor *>::iterator sit;
 
@@ -197,9 +203,9 @@ void KX_CollisionEventManager::NextFrame()
 			}
 		}
 		// Run python callbacks
-		const PHY_ICollData *colldata = collision.colldata;
-		KX_CollisionContactPointList contactPointList0 = KX_CollisionContactPointList(colldata, collision.isFirst);
-		KX_CollisionContactPointList contactPointList1 = KX_CollisionContactPointList(colldata, !collision.isFirst);
+		const PHY_ICollData *colldata = collision.collData;
+		KX_CollisionContactPointList contactPointList0 = KX_CollisionContactPointList(colldata, collision.first);
+		KX_CollisionContactPointList contactPointList1 = KX_CollisionContactPointList(colldata, !collision.first);
 		kxObj1->RunCollisionCallbacks(kxObj2, contactPointList0);
 		kxObj2->RunCollisionCallbacks(kxObj1, contactPointList1);
 	}
@@ -220,35 +226,3 @@ PHY_IPhysicsEnvironment *KX_CollisionEventManager::GetPhysicsEnvironment()
 {
 	return m_physEnv;
 }
-
-KX_CollisionEventManager::NewCollision::NewCollision(PHY_IPhysicsController *_first, PHY_IPhysicsController *_second,
-		const PHY_ICollData *_colldata, bool _isfirst)
-	:first(_first),
-	second(_second),
-	colldata(_colldata),
-	isFirst(_isfirst)
-{
-}
-
-KX_CollisionEventManager::NewCollision::NewCollision(const NewCollision &to_copy)
-	:first(to_copy.first),
-	second(to_copy.second),
-	colldata(to_copy.colldata),
-	isFirst(to_copy.isFirst)
-{
-}
-
-bool KX_CollisionEventManager::NewCollision::operator<(const NewCollision &other) const
-{
-	// See strict weak ordering: https://support.microsoft.com/en-us/kb/949171.
-	if (first == other.first) {
-		if (second == other.second) {
-			if (colldata == other.colldata) {
-				return isFirst < other.isFirst;
-			}
-			return colldata < other.colldata;
-		}
-		return second < other.second;
-	}
-	return first < other.first;
-}
@@ -36,43 +36,24 @@
 #include "SCA_EventManager.h"
 #include "KX_CollisionSensor.h"
 #include "KX_GameObject.h"
+#include "PHY_DynamicTypes.h"
 
 #include <vector>
-#include <set>
 
 class SCA_ISensor;
 class PHY_IPhysicsEnvironment;
 
 class KX_CollisionEventManager : public SCA_EventManager
 {
-	/**
-	 * Contains two colliding objects and the first contact point.
-	 */
-	class NewCollision
-	{
-	public:
-		PHY_IPhysicsController *first;
-		PHY_IPhysicsController *second;
-		const PHY_ICollData *colldata;
-		bool isFirst;
-
-		/**
-		 * Creates a copy of the given PHY_ICollData; freeing that copy should be done by the owner of
-		 * the NewCollision object.
-		 *
-		 * This allows us to efficiently store NewCollision objects in a std::set without creating more
-		 * copies of colldata, as the NewCollision copy constructor reuses the pointer and doesn't clone
-		 * it again. */
-		NewCollision(PHY_IPhysicsController *first, PHY_IPhysicsController *second, const PHY_ICollData *colldata, bool isFirst);
-		NewCollision(const NewCollision &to_copy);
-		bool operator<(const NewCollision &other) const;
-	};
-
 	PHY_IPhysicsEnvironment *m_physEnv;
-	std::set<NewCollision> m_newCollisions;
+	/** Contact pairs of the last physics step, the collision data are
+	 * owned by the physics environment and valid until its next step.
+	 */
+	std::vector<PHY_CollisionPair> m_newCollisions;
 
 	static bool newCollisionResponse(void *client_data, PHY_IPhysicsController *ctrl1, PHY_IPhysicsController *ctrl2,
 									 const PHY_ICollData *coll_data, bool first);
+	static void newCollisionsResponse(void *client_data, const PHY_CollisionPair *pairs, unsigned int count);
 	static bool newBroadphaseResponse(void *client_data, PHY_IPhysicsController *ctrl1, PHY_IPhysicsController *ctrl2,
 									 const PHY_ICollData *coll_data, bool first);
 
@@ -3,37 +3,72 @@
 
 #include "SG_Node.h"
 
-KX_CullingHandler::KX_CullingHandler(std::vector<KX_GameObject *>& objects, const SG_Frustum& frustum)
+KX_CullingHandler::KX_CullingHandler(std::vector<KX_GameObject *>& objects, const SG_Frustum& frustum, bool setCulled)
 	:m_activeObjects(objects),
-	m_frustum(frustum)
+	m_frustum(frustum),
+	m_setCulled(setCulled)
 {
 }
 
 void KX_CullingHandler::Process(KX_GameObject *object)
 {
 	SG_Node *sgnode = object->GetSGNode();
-	SG_CullingNode *node = object->GetCullingNode();
+	const SG_BBox& aabb = object->GetCullingNode()->GetAabb();
 
 	const mt::mat3x4 trans = sgnode->GetWorldTransform();
 	const mt::vec3 &scale = sgnode->GetWorldScaling();
-	const SG_BBox& aabb = node->GetAabb();
-
-	bool culled = true;
 	const float maxscale = std::max(std::max(fabs(scale.x), fabs(scale.y)), fabs(scale.z));
-	const SG_Frustum::TestType sphereTest = m_frustum.SphereInsideFrustum(trans * aabb.GetCenter(), maxscale * aabb.GetRadius());
+	const mt::vec3 center = trans * aabb.GetCenter();
+
+	m_objects.push_back(object);
+	m_centersX.push_back(center.x);
+	m_centersY.push_back(center.y);
+	m_centersZ.push_back(center.z);
+	m_radius.push_back(maxscale * aabb.GetRadius());
+}
+
+void KX_CullingHandler::Cull()
+{
+	const unsigned int count = m_objects.size();
+	// The batch test proceeds 4 spheres at once, pad the buffers.
+	const unsigned int size = (count + 3) & ~3;
+	m_centersX.resize(size, 0.0f);
+	m_centersY.resize(size, 0.0f);
+	m_centersZ.resize(size, 0.0f);
+	m_radius.resize(size, 0.0f);
+	m_results.resize(size);
 
 	// First test if the sphere is in the frustum as it is faster to test than box.
-	if (sphereTest == SG_Frustum::INSIDE) {
-		culled = false;
-	}
-	// If the sphere intersects we made a box test because the box could be not homogeneous.
-	else if (sphereTest == SG_Frustum::INTERSECT) {
-		const mt::mat4 mat = mt::mat4::FromAffineTransform(trans);
-		culled = (m_frustum.AabbInsideFrustum(aabb.GetMin(), aabb.GetMax(), mat) == SG_Frustum::OUTSIDE);
-	}
+	m_frustum.SpheresInsideFrustum(m_centersX.data(), m_centersY.data(), m_centersZ.data(), m_radius.data(),
+			count, m_results.data());
+
+	for (unsigned int i = 0; i < count; ++i) {
+		KX_GameObject *object = m_objects[i];
+		SG_CullingNode *node = object->GetCullingNode();
 
-	node->SetCulled(culled);
-	if (!culled) {
-		m_activeObjects.push_back(object);
+		bool culled = true;
+		const SG_Frustum::TestType sphereTest = m_results[i];
+		if (sphereTest == SG_Frustum::INSIDE) {
+			culled = false;
+		}
+		// If the sphere intersects we made a box test because the box could be not homogeneous.
+		else if (sphereTest == SG_Frustum::INTERSECT) {
+			const SG_BBox& aabb = node->GetAabb();
+			const mt::mat4 mat = mt::mat4::FromAffineTransform(object->GetSGNode()->GetWorldTransform());
+			culled = (m_frustum.AabbInsideFrustum(aabb.GetMin(), aabb.GetMax(), mat) == SG_Frustum::OUTSIDE);
+		}
+
+		if (m_setCulled) {
+			node->SetCulled(culled);
+		}
+		if (!culled) {
+			m_activeObjects.push_back(object);
+		}
 	}
+
+	m_objects.clear();
+	m_centersX.clear();
+	m_centersY.clear();
+	m_centersZ.clear();
+	m_radius.clear();
 }
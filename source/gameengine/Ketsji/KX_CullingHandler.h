@@ -13,15 +13,32 @@ private:
 	std::vector<KX_GameObject *>& m_activeObjects;
 	/// The camera frustum data.
 	const SG_Frustum& m_frustum;
+	/// Store the culling result in the objects, disabled for culling passes run in parallel.
+	bool m_setCulled;
+
+	/// Objects waiting for the culling test.
+	std::vector<KX_GameObject *> m_objects;
+	/// World bounding sphere of the waiting objects, stored per component for batch tests.
+	std::vector<float> m_centersX;
+	std::vector<float> m_centersY;
+	std::vector<float> m_centersZ;
+	std::vector<float> m_radius;
+	/// Sphere test results of the waiting objects.
+	std::vector<SG_Frustum::TestType> m_results;
 
 public:
-	KX_CullingHandler(std::vector<KX_GameObject *>& objects, const SG_Frustum& frustum);
+	KX_CullingHandler(std::vector<KX_GameObject *>& objects, const SG_Frustum& frustum, bool setCulled);
 	~KX_CullingHandler() = default;
 
-	/** Process the culling of a new object, if the culling succeeded the
-	 * object is added in m_activeObjects.
+	/** Register a new object for the culling, the object is tested
+	 * only during the next call to Cull.
 	 */
 	void Process(KX_GameObject *object);
+
+	/** Process the culling of all the registered objects, if the culling
+	 * succeeded the object is added in m_activeObjects.
+	 */
+	void Cull();
 };
 
 #endif  // __KX_CULLING_HANDLER_H__
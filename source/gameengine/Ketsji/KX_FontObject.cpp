@@ -131,7 +131,7 @@ void KX_FontObject::AddMeshUser()
 	m_meshUser = new RAS_TextUser(&m_clientInfo, m_boundingBox);
 
 	// Make sure the mesh user get the matrix even if the object doesn't move.
-	NodeGetWorldTransform().PackFromAffineTransform(m_meshUser->GetMatrix());
+	m_meshUser->SetMatrix(NodeGetWorldTransform());
 
 	RAS_BucketManager *bucketManager = GetScene()->GetBucketManager();
 	RAS_DisplayArrayBucket *arrayBucket = bucketManager->GetTextDisplayArrayBucket();
@@ -144,7 +144,7 @@ void KX_FontObject::UpdateBuckets()
 {
 	// Update datas and add mesh slot to be rendered only if the object is not culled.
 	if (m_sgNode->IsDirty(SG_Node::DIRTY_RENDER)) {
-		NodeGetWorldTransform().PackFromAffineTransform(m_meshUser->GetMatrix());
+		m_meshUser->SetMatrix(NodeGetWorldTransform());
 		m_sgNode->ClearDirty(SG_Node::DIRTY_RENDER);
 	}
 
@@ -191,6 +191,9 @@ void KX_FontObject::SetText(const std::string& text)
 	mt::vec2 max;
 	GetTextAabb(min, max);
 	m_boundingBox->SetAabb(mt::vec3(min.x, min.y, 0.0f), mt::vec3(max.x, max.y, 0.0f));
+
+	// The text changes the shape of the object without moving it.
+	m_sgNode->SetDirty(SG_Node::DIRTY_CULLING);
 }
 
 void KX_FontObject::UpdateTextFromProperty()
@@ -117,6 +117,10 @@ KX_GameObject::KX_GameObject(
 	m_bVisible(true),
 	m_bOccluder(false),
 	m_autoUpdateBounds(false),
+	m_boundsFrame(0),
+	m_delayedRemoval(false),
+	m_pendingRemoval(false),
+	m_lifespanEnd(-1.0),
 	m_physicsController(nullptr),
 	m_graphicController(nullptr),
 	m_sgNode(new SG_Node(this,sgReplicationInfo,callbacks)),
@@ -150,6 +154,10 @@ KX_GameObject::KX_GameObject(const KX_GameObject& other)
 	m_bOccluder(other.m_bOccluder),
 	m_activityCullingInfo(other.m_activityCullingInfo),
 	m_autoUpdateBounds(other.m_autoUpdateBounds),
+	m_boundsFrame(0),
+	m_delayedRemoval(false),
+	m_pendingRemoval(false),
+	m_lifespanEnd(-1.0),
 	m_physicsController(nullptr),
 	m_graphicController(nullptr),
 	m_sgNode(nullptr),
@@ -479,6 +487,12 @@ void KX_GameObject::StopAction(short layer)
 	GetActionManager()->StopAction(layer);
 }
 
+void KX_GameObject::StopAllActions()
+{
+	// The action manager is created again at the next played action.
+	m_actionManager.reset();
+}
+
 void KX_GameObject::RemoveTaggedActions()
 {
 	GetActionManager()->RemoveTaggedActions();
@@ -689,15 +703,18 @@ void KX_GameObject::AddMeshUser()
 	for (size_t i = 0; i < m_meshes.size(); ++i) {
 		m_meshUser = m_meshes[i]->AddMeshUser(&m_clientInfo, GetDeformer());
 		// Make sure the mesh user get the matrix even if the object doesn't move.
-		NodeGetWorldTransform().PackFromAffineTransform(m_meshUser->GetMatrix());
+		m_meshUser->SetMatrix(NodeGetWorldTransform());
 	}
+
+	// A new mesh changes the shape of the object without moving it.
+	m_sgNode->SetDirty(SG_Node::DIRTY_CULLING);
 }
 
 void KX_GameObject::UpdateBuckets()
 {
 	// Update datas and add mesh slot to be rendered only if the object is not culled.
 	if (m_sgNode->IsDirty(SG_Node::DIRTY_RENDER)) {
-		NodeGetWorldTransform().PackFromAffineTransform(m_meshUser->GetMatrix());
+		m_meshUser->SetMatrix(NodeGetWorldTransform());
 		m_sgNode->ClearDirty(SG_Node::DIRTY_RENDER);
 	}
 
@@ -1579,7 +1596,7 @@ void KX_GameObject::SetComponents(EXP_ListValue<KX_PythonComponent> *components)
 	m_components = components;
 }
 
-void KX_GameObject::UpdateComponents()
+void KX_GameObject::UpdateComponents(bool costProfile)
 {
 #ifdef WITH_PYTHON
 	if (!m_components) {
@@ -1587,6 +1604,7 @@ void KX_GameObject::UpdateComponents()
 	}
 
 	for (KX_PythonComponent *comp : m_components) {
+		SCA_LogicCostScope costScope(costProfile ? &comp->GetCost() : nullptr);
 		comp->Update();
 	}
 
@@ -2416,13 +2434,14 @@ PyObject *KX_GameObject::pyattr_get_life(EXP_PyObjectPlus *self_v, const EXP_PYA
 {
 	KX_GameObject* self = static_cast<KX_GameObject*>(self_v);
 
-	EXP_Value *life = self->GetProperty("::timebomb");
-	if (life)
-		// this convert the timebomb seconds to frames, hard coded 50.0f (assuming 50fps)
-		// value hardcoded in KX_Scene::AddReplicaObject()
-		return PyFloat_FromDouble(life->GetNumber() * 50.0);
-	else
+	const double end = self->GetLifespanEnd();
+	if (end < 0.0) {
 		Py_RETURN_NONE;
+	}
+
+	// This convert the remaining seconds to frames, hard coded 50.0f (assuming 50fps)
+	// value hardcoded in KX_Scene::SetObjectLifespan().
+	return PyFloat_FromDouble((end - self->GetScene()->GetLifespanTime()) * 50.0);
 }
 
 PyObject *KX_GameObject::pyattr_get_mass(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef)
@@ -123,6 +123,15 @@ protected:
 	ActivityCullingInfo m_activityCullingInfo;
 
 	bool								m_autoUpdateBounds;
+	/// Scene bounds frame of the last bounds update, see KX_Scene::UpdateObjectsBounds.
+	unsigned int m_boundsFrame;
+
+	/// The object is in the delayed removal list of its scene, see KX_Scene::DelayedRemoveObject.
+	bool m_delayedRemoval;
+	/// The object is removed from the scene lists at the end of the current objects removal.
+	bool m_pendingRemoval;
+	/// Scene lifespan time at which the object is removed, negative if it lives forever.
+	double m_lifespanEnd;
 
 	std::unique_ptr<PHY_IPhysicsController> m_physicsController;
 	std::unique_ptr<PHY_IGraphicController> m_graphicController;
@@ -295,6 +304,11 @@ public:
 	 */
 	void StopAction(short layer);
 
+	/**
+	 * Stop playing the actions of all the layers
+	 */
+	void StopAllActions();
+
 	/**
 	 * Remove playing tagged actions.
 	 */
@@ -521,6 +535,36 @@ public:
 	BL_ConvertObjectInfo *GetConvertObjectInfo() const;
 	void SetConvertObjectInfo(BL_ConvertObjectInfo *info);
 
+	bool IsDelayedRemoval() const
+	{
+		return m_delayedRemoval;
+	}
+
+	void SetDelayedRemoval(bool delayed)
+	{
+		m_delayedRemoval = delayed;
+	}
+
+	bool IsPendingRemoval() const
+	{
+		return m_pendingRemoval;
+	}
+
+	void SetPendingRemoval(bool pending)
+	{
+		m_pendingRemoval = pending;
+	}
+
+	double GetLifespanEnd() const
+	{
+		return m_lifespanEnd;
+	}
+
+	void SetLifespanEnd(double end)
+	{
+		m_lifespanEnd = end;
+	}
+
 	bool IsDupliGroup()
 	{ 
 		Object *blenderobj = GetBlenderObject();
@@ -798,6 +842,18 @@ public:
 		return m_autoUpdateBounds;
 	}
 
+	/// Get the scene bounds frame of the last bounds update.
+	inline unsigned int GetBoundsFrame() const
+	{
+		return m_boundsFrame;
+	}
+
+	/// Mark the bounds updated for the scene bounds frame.
+	inline void SetBoundsFrame(unsigned int frame)
+	{
+		m_boundsFrame = frame;
+	}
+
 	/** Update the game object bounding box (AABB) by using the one existing in the
 	 * mesh or the mesh deformer.
 	 * \param force Force the AABB update even if the object doesn't allow auto update or if the mesh is
@@ -859,8 +915,10 @@ public:
 	/// Add a components.
 	void SetComponents(EXP_ListValue<KX_PythonComponent> *components);
 
-	/// Updates the components.
-	void UpdateComponents();
+	/** Updates the components.
+	 * \param costProfile Measure the cost of each component update.
+	 */
+	void UpdateComponents(bool costProfile);
 
 	KX_Scene*	GetScene();
 
@@ -86,5 +86,11 @@ const std::string& KX_GetOrigPath()
 
 void KX_RasterizerDrawDebugLine(const mt::vec3& from,const mt::vec3& to,const mt::vec4& color)
 {
-	g_engine->GetRasterizer()->GetDebugDraw(g_scene).DrawLine(from, to, color);
+	RAS_Rasterizer *rasterizer = g_engine->GetRasterizer();
+	// The lines would be accumulated and never drawn.
+	if (rasterizer->IsHeadless()) {
+		return;
+	}
+
+	rasterizer->GetDebugDraw(g_scene).DrawLine(from, to, color);
 }
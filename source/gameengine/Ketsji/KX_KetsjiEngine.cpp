@@ -35,7 +35,9 @@
 #endif
 
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 
+#include <algorithm>
 #include <boost/format.hpp>
 
 #include "BLI_task.h"
@@ -76,6 +78,8 @@
 
 #include "KX_NavMeshObject.h"
 
+#include "SCA_LogicCost.h"
+
 #define DEFAULT_LOGIC_TIC_RATE 60.0
 
 
@@ -185,6 +189,7 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system)
 #endif
 
 	m_taskscheduler = BLI_task_scheduler_create(TASK_SCHEDULER_AUTO_THREADS);
+	m_scenePool = BLI_task_pool_create(m_taskscheduler, &m_scenePoolData);
 
 	m_scenes = new EXP_ListValue<KX_Scene>();
 }
@@ -198,6 +203,8 @@ KX_KetsjiEngine::~KX_KetsjiEngine()
 	Py_CLEAR(m_pyprofiledict);
 #endif
 
+	BLI_task_pool_free(m_scenePool);
+
 	if (m_taskscheduler)
 		BLI_task_scheduler_free(m_taskscheduler);
 
@@ -220,6 +227,7 @@ void KX_KetsjiEngine::SetRasterizer(RAS_Rasterizer *rasterizer)
 {
 	BLI_assert(rasterizer);
 	m_rasterizer = rasterizer;
+	m_rasterizer->SetTaskScheduler(m_taskscheduler);
 }
 
 void KX_KetsjiEngine::SetNetworkMessageManager(KX_NetworkMessageManager *manager)
@@ -267,6 +275,8 @@ void KX_KetsjiEngine::BeginFrame()
 
 void KX_KetsjiEngine::EndFrame()
 {
+	CM_ProfileScope profileScope("render", "EndFrame");
+
 	m_rasterizer->MotionBlur();
 
 	m_logger.StartLog(tc_overhead, m_kxsystem->GetTimeInSeconds());
@@ -282,6 +292,27 @@ void KX_KetsjiEngine::EndFrame()
 		RenderDebugProperties();
 	}
 
+	UpdateProfile();
+
+	m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
+	m_rasterizer->EndFrame();
+
+	m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
+	m_canvas->FlushScreenshots();
+
+	// swap backbuffer (drawing into this buffer) <-> front/visible buffer
+	m_logger.StartLog(tc_latency, m_kxsystem->GetTimeInSeconds());
+	{
+		CM_ProfileScope swapScope("render", "SwapBuffers");
+		m_canvas->SwapBuffers();
+	}
+	m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
+
+	m_canvas->EndDraw();
+}
+
+void KX_KetsjiEngine::UpdateProfile()
+{
 	double tottime = m_logger.GetAverage();
 	if (tottime < 1e-6)
 		tottime = 1e-6;
@@ -302,23 +333,12 @@ void KX_KetsjiEngine::EndFrame()
 
 	// Go to next profiling measurement, time spent after this call is shown in the next frame.
 	m_logger.NextMeasurement(m_kxsystem->GetTimeInSeconds());
-
-	m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
-	m_rasterizer->EndFrame();
-
-	m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
-	m_canvas->FlushScreenshots();
-
-	// swap backbuffer (drawing into this buffer) <-> front/visible buffer
-	m_logger.StartLog(tc_latency, m_kxsystem->GetTimeInSeconds());
-	m_canvas->SwapBuffers();
-	m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
-
-	m_canvas->EndDraw();
 }
 
 bool KX_KetsjiEngine::NextFrame()
 {
+	CM_ProfileScope profileScope("engine", "NextFrame");
+
 	m_logger.StartLog(tc_services, m_kxsystem->GetTimeInSeconds());
 
 	/*
@@ -408,76 +428,178 @@ bool KX_KetsjiEngine::NextFrame()
 		}
 #endif  // WITH_SDL
 
-		// for each scene, call the proceed functions
-		for (KX_Scene *scene : m_scenes) {
-			/* Suspension holds the physics and logic processing for an
-			 * entire scene. Objects can be suspended individually, and
-			 * the settings for that precede the logic and physics
-			 * update. */
-			m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
+		if (m_flags & PARALLEL_SCENES) {
+			ProceedScenesParallel(timestep, framestep);
+		}
+		else {
+			ProceedScenes(timestep, framestep);
+		}
+
+		m_logger.StartLog(tc_network, m_kxsystem->GetTimeInSeconds());
+		m_networkMessageManager->ClearMessages();
+
+		// update system devices
+		m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
+		if (m_inputDevice) {
+			m_inputDevice->ClearInputs();
+		}
+
+		UpdateSuspendedScenes(framestep);
+		// scene management
+		ProcessScheduledScenes();
+	}
+
+	// Start logging time spent outside main loop
+	m_logger.StartLog(tc_outside, m_kxsystem->GetTimeInSeconds());
+
+	return doRender && m_doRender;
+}
+
+static void update_parents_task_func(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	KX_Scene *scene = (KX_Scene *)taskdata;
+	scene->UpdateParents();
+}
+
+static void proceed_physics_task_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+{
+	const KX_KetsjiEngine::ScenePoolData *data = (KX_KetsjiEngine::ScenePoolData *)BLI_task_pool_userdata(pool);
+	KX_Scene *scene = (KX_Scene *)taskdata;
+
+	// Actuators can affect the scenegraph.
+	scene->UpdateParents();
+	scene->GetPhysicsEnvironment()->ProceedDeltaTime(data->curtime, data->timestep, data->framestep);
+	scene->UpdateParents();
+}
+
+void KX_KetsjiEngine::ProceedScenes(double timestep, double framestep)
+{
+	// for each scene, call the proceed functions
+	for (KX_Scene *scene : m_scenes) {
+		/* Suspension holds the physics and logic processing for an
+		 * entire scene. Objects can be suspended individually, and
+		 * the settings for that precede the logic and physics
+		 * update. */
+		m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
 
-			scene->UpdateObjectActivity();
+		scene->UpdateObjectActivity();
 
-			if (!scene->IsSuspended()) {
-				m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
-				// set Python hooks for each scene
+		if (!scene->IsSuspended()) {
+			m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
+			// set Python hooks for each scene
 #ifdef WITH_PYTHON
-				PHY_SetActiveEnvironment(scene->GetPhysicsEnvironment());
+			PHY_SetActiveEnvironment(scene->GetPhysicsEnvironment());
 #endif
-				KX_SetActiveScene(scene);
-
-				// Process sensors, and controllers
-				m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
-				scene->LogicBeginFrame(m_frameTime, framestep);
+			KX_SetActiveScene(scene);
 
-				// Scenegraph needs to be updated again, because Logic Controllers
-				// can affect the local matrices.
-				m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
-				scene->UpdateParents();
+			// Process sensors, and controllers
+			m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
+			scene->LogicBeginFrame(m_frameTime, framestep);
 
-				// Process actuators
+			// Scenegraph needs to be updated again, because Logic Controllers
+			// can affect the local matrices.
+			m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
+			scene->UpdateParents();
 
-				// Do some cleanup work for this logic frame
-				m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
-				scene->LogicUpdateFrame(m_frameTime);
+			// Process actuators
 
-				scene->LogicEndFrame();
+			// Do some cleanup work for this logic frame
+			m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
+			scene->LogicUpdateFrame(m_frameTime);
 
-				// Actuators can affect the scenegraph
-				m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
-				scene->UpdateParents();
+			scene->LogicEndFrame();
 
-				m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
+			// Actuators can affect the scenegraph
+			m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
+			scene->UpdateParents();
 
-				// Perform physics calculations on the scene. This can involve
-				// many iterations of the physics solver.
-				scene->GetPhysicsEnvironment()->ProceedDeltaTime(m_frameTime, timestep, framestep);//m_deltatimerealDeltaTime);
+			m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
 
-				m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
-				scene->UpdateParents();
-			}
+			// Perform physics calculations on the scene. This can involve
+			// many iterations of the physics solver.
+			scene->GetPhysicsEnvironment()->ProceedDeltaTime(m_frameTime, timestep, framestep);//m_deltatimerealDeltaTime);
 
-			m_logger.StartLog(tc_services, m_kxsystem->GetTimeInSeconds());
+			m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
+			scene->UpdateParents();
 		}
 
-		m_logger.StartLog(tc_network, m_kxsystem->GetTimeInSeconds());
-		m_networkMessageManager->ClearMessages();
+		m_logger.StartLog(tc_services, m_kxsystem->GetTimeInSeconds());
+	}
+}
 
-		// update system devices
+void KX_KetsjiEngine::ProceedScenesParallel(double timestep, double framestep)
+{
+	m_parallelScenes.clear();
+
+	/* The logic can run python and access any scene through the active scene,
+	 * it is then proceeded scene after scene as in ProceedScenes. */
+	for (KX_Scene *scene : m_scenes) {
 		m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
-		if (m_inputDevice) {
-			m_inputDevice->ClearInputs();
+
+		scene->UpdateObjectActivity();
+
+		if (!scene->IsSuspended()) {
+#ifdef WITH_PYTHON
+			PHY_SetActiveEnvironment(scene->GetPhysicsEnvironment());
+#endif
+			KX_SetActiveScene(scene);
+
+			// Process sensors, and controllers
+			scene->LogicBeginFrame(m_frameTime, framestep);
+
+			m_parallelScenes.push_back(scene);
 		}
+	}
 
-		UpdateSuspendedScenes(framestep);
-		// scene management
-		ProcessScheduledScenes();
+	// Scenegraph needs to be updated again, because Logic Controllers can affect the local matrices.
+	m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
+	for (KX_Scene *scene : m_parallelScenes) {
+		BLI_task_pool_push(m_scenePool, update_parents_task_func, scene, false, TASK_PRIORITY_HIGH);
 	}
+	BLI_task_pool_work_and_wait(m_scenePool);
 
-	// Start logging time spent outside main loop
-	m_logger.StartLog(tc_outside, m_kxsystem->GetTimeInSeconds());
+	m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
+	for (KX_Scene *scene : m_parallelScenes) {
+#ifdef WITH_PYTHON
+		PHY_SetActiveEnvironment(scene->GetPhysicsEnvironment());
+#endif
+		KX_SetActiveScene(scene);
 
-	return doRender && m_doRender;
+		// Process actuators
+		scene->LogicUpdateFrame(m_frameTime);
+
+		// Do some cleanup work for this logic frame
+		scene->LogicEndFrame();
+	}
+
+	/* Perform physics calculations on all the scenes, each scene owns its physics
+	 * environment so they can be stepped independently. But the environments share
+	 * process wide settings (Bullet global variables), only the scenes using the same
+	 * values are stepped together, after applying these values once. */
+	m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
+	m_scenePoolData.curtime = m_frameTime;
+	m_scenePoolData.timestep = timestep;
+	m_scenePoolData.framestep = framestep;
+	while (!m_parallelScenes.empty()) {
+		PHY_IPhysicsEnvironment *firstEnv = m_parallelScenes.front()->GetPhysicsEnvironment();
+		const std::vector<KX_Scene *>::iterator end = std::stable_partition(m_parallelScenes.begin(), m_parallelScenes.end(),
+				[firstEnv](KX_Scene *scene) {
+			PHY_IPhysicsEnvironment *env = scene->GetPhysicsEnvironment();
+			return (firstEnv->HasSameSharedSettings(env) && env->HasSameSharedSettings(firstEnv));
+		});
+
+		for (std::vector<KX_Scene *>::iterator it = m_parallelScenes.begin(); it != end; ++it) {
+			(*it)->GetPhysicsEnvironment()->ApplySharedSettings();
+		}
+		for (std::vector<KX_Scene *>::iterator it = m_parallelScenes.begin(); it != end; ++it) {
+			BLI_task_pool_push(m_scenePool, proceed_physics_task_func, *it, false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(m_scenePool);
+
+		m_parallelScenes.erase(m_parallelScenes.begin(), end);
+	}
+
+	m_logger.StartLog(tc_services, m_kxsystem->GetTimeInSeconds());
 }
 
 void KX_KetsjiEngine::UpdateSuspendedScenes(double framestep)
@@ -627,11 +749,15 @@ KX_KetsjiEngine::RenderData KX_KetsjiEngine::GetRenderData()
 
 void KX_KetsjiEngine::Render()
 {
+	CM_ProfileScope profileScope("render", "Render");
+
 	m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
 
 	BeginFrame();
 
 	for (KX_Scene *scene : m_scenes) {
+		// Update deformers and bounds once for all the culling passes of the frame.
+		scene->UpdateObjectsBounds();
 		// shadow buffers
 		RenderShadowBuffers(scene);
 		// Render only independent texture renderers here.
@@ -829,6 +955,20 @@ void KX_KetsjiEngine::GetSceneViewport(KX_Scene *scene, KX_Camera *cam, const RA
 	}
 }
 
+void KX_KetsjiEngine::UpdateWithoutRender()
+{
+	CM_ProfileScope profileScope("engine", "UpdateWithoutRender");
+
+	m_logger.StartLog(tc_animations, m_kxsystem->GetTimeInSeconds());
+	for (KX_Scene *scene : m_scenes) {
+		UpdateAnimations(scene);
+	}
+
+	UpdateProfile();
+
+	m_logger.StartLog(tc_outside, m_kxsystem->GetTimeInSeconds());
+}
+
 void KX_KetsjiEngine::UpdateAnimations(KX_Scene *scene)
 {
 	if (scene->IsSuspended()) {
@@ -848,36 +988,82 @@ void KX_KetsjiEngine::RenderShadowBuffers(KX_Scene *scene)
 		light->Update();
 	}
 
-	if (m_rasterizer->GetDrawingMode() == RAS_Rasterizer::RAS_TEXTURED) {
-		for (KX_LightObject *light : lightlist) {
-			RAS_ILightObject *raslight = light->GetLightData();
-			if (light->GetVisible() && raslight->HasShadowBuffer() && raslight->NeedShadowUpdate()) {
-				/* make temporary camera */
-				RAS_CameraData camdata = RAS_CameraData();
-				KX_Camera *cam = new KX_Camera(scene, scene->m_callbacks, camdata, true);
-				cam->SetName("__shadow__cam__");
+	if (m_rasterizer->GetDrawingMode() != RAS_Rasterizer::RAS_TEXTURED) {
+		return;
+	}
+
+	// Lights rendering a shadow buffer and their shadow casters.
+	std::vector<KX_LightObject *> lights;
+	std::vector<KX_Scene::CullingPass> passes;
+	for (KX_LightObject *light : lightlist) {
+		RAS_ILightObject *raslight = light->GetLightData();
+		if (light->GetVisible() && raslight->HasShadowBuffer() && raslight->NeedShadowUpdate()) {
+			lights.push_back(light);
+			passes.push_back({SG_Frustum(raslight->GetShadowFrustumMatrix()), raslight->GetShadowLayer(), {}});
+		}
+		else {
+			// The shadow buffer may be used by an other light or outdated when rendered again.
+			light->InvalidateShadowCache();
+		}
+	}
+
+	if (lights.empty()) {
+		return;
+	}
+
+	{
+		CM_ProfileScope profileScope("render", "Shadow culling");
+		scene->CalculateVisibleMeshes(passes, m_flags & PARALLEL_SHADOWS);
+	}
+
+	const bool cacheShadows = (m_flags & CACHE_SHADOWS);
+
+	for (unsigned short i = 0, size = lights.size(); i < size; ++i) {
+		KX_LightObject *light = lights[i];
+		RAS_ILightObject *raslight = light->GetLightData();
+		const std::vector<KX_GameObject *>& objects = passes[i].m_objects;
+
+		/* Static shadows are rendered on user request only, in this case the
+		 * request could come from a change not visible to the shadow cache. */
+		if (cacheShadows && !raslight->m_staticShadow) {
+			if (light->UpdateShadowCache(passes[i].m_frustum.GetMatrix(), objects)) {
+				continue;
+			}
+		}
+		else {
+			light->InvalidateShadowCache();
+		}
+
+		CM_ProfileScope profileScope("render");
+		if (profileScope.IsActive()) {
+			profileScope.SetName(light->GetName(), "Shadow");
+		}
 
-				mt::mat3x4 camtrans;
+		KX_Camera *cam = light->GetShadowCamera();
 
-				/* binds framebuffer object, sets up camera .. */
-				raslight->BindShadowBuffer(m_canvas, cam, camtrans);
+		mt::mat3x4 camtrans;
 
-				std::vector<KX_GameObject *> objects;
-				/* update scene */
-				scene->CalculateVisibleMeshes(objects, cam, raslight->GetShadowLayer());
+		/* binds framebuffer object, sets up camera .. */
+		raslight->BindShadowBuffer(m_canvas, cam, camtrans);
 
-				m_logger.StartLog(tc_animations, m_kxsystem->GetTimeInSeconds());
-				UpdateAnimations(scene);
-				m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
+		m_logger.StartLog(tc_animations, m_kxsystem->GetTimeInSeconds());
+		UpdateAnimations(scene);
+		m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
 
-				/* render */
-				m_rasterizer->Clear(RAS_Rasterizer::RAS_DEPTH_BUFFER_BIT | RAS_Rasterizer::RAS_COLOR_BUFFER_BIT);
-				// Send a nullptr off screen because the viewport is binding it's using its own private one.
-				scene->RenderBuckets(objects, RAS_Rasterizer::RAS_SHADOW, camtrans, m_rasterizer, nullptr);
+		/* render */
+		m_rasterizer->Clear(RAS_Rasterizer::RAS_DEPTH_BUFFER_BIT | RAS_Rasterizer::RAS_COLOR_BUFFER_BIT);
+		// Send a nullptr off screen because the viewport is binding it's using its own private one.
+		scene->RenderBuckets(objects, RAS_Rasterizer::RAS_SHADOW, camtrans, m_rasterizer, nullptr);
 
-				/* unbind framebuffer object, restore drawmode, free camera */
-				raslight->UnbindShadowBuffer();
-				cam->Release();
+		/* unbind framebuffer object, restore drawmode */
+		raslight->UnbindShadowBuffer();
+	}
+
+	if (cacheShadows) {
+		// The shadow caches of all the lights are up to date with the last moves of the casters.
+		for (const KX_Scene::CullingPass& pass : passes) {
+			for (KX_GameObject *gameobj : pass.m_objects) {
+				gameobj->GetSGNode()->ClearDirty(SG_Node::DIRTY_CULLING);
 			}
 		}
 	}
@@ -968,6 +1154,11 @@ void KX_KetsjiEngine::RenderCamera(KX_Scene *scene, const CameraRenderData& came
 	const RAS_Rect &area = cameraFrameData.m_area;
 	const RAS_Rect &viewport = cameraFrameData.m_viewport;
 
+	CM_ProfileScope profileScope("render");
+	if (profileScope.IsActive()) {
+		profileScope.SetName(rendercam->GetName(), "Camera");
+	}
+
 	KX_SetActiveScene(scene);
 
 	/* Render texture probes depending of the the current viewport and area, these texture probes are commonly the planar map
@@ -1043,6 +1234,11 @@ void KX_KetsjiEngine::RenderCamera(KX_Scene *scene, const CameraRenderData& came
  */
 RAS_OffScreen *KX_KetsjiEngine::PostRenderScene(KX_Scene *scene, RAS_OffScreen *inputofs, RAS_OffScreen *targetofs)
 {
+	CM_ProfileScope profileScope("render");
+	if (profileScope.IsActive()) {
+		profileScope.SetName(scene->GetName(), "PostRender");
+	}
+
 	KX_SetActiveScene(scene);
 
 	m_rasterizer->FlushDebugDraw(scene, m_canvas);
@@ -1194,6 +1390,35 @@ void KX_KetsjiEngine::RenderDebugProperties()
 			debugDraw.RenderBox2d(mt::vec2(xcoord + (int)(2.2 * profile_indent), ycoord), boxSize, white);
 			ycoord += const_ysize;
 		}
+
+		// Display the most expensive logic bricks and components.
+		if (m_flags & PROFILE_LOGIC) {
+			debugDraw.RenderText2d("Logic Costs :", mt::vec2(xcoord + const_xindent + title_xmargin, ycoord), white);
+			ycoord += const_ysize;
+
+			std::vector<KX_Scene::LogicCost> costs;
+			for (KX_Scene *scene : m_scenes) {
+				scene->GetLogicCosts(costs);
+			}
+
+			static const unsigned int maxCosts = 10;
+			const unsigned int numCosts = std::min(maxCosts, (unsigned int)costs.size());
+			std::partial_sort(costs.begin(), costs.begin() + numCosts, costs.end(),
+				[](const KX_Scene::LogicCost& cost1, const KX_Scene::LogicCost& cost2) {
+					return cost1.m_cost->GetTime() > cost2.m_cost->GetTime();
+				});
+
+			for (unsigned int i = 0; i < numCosts; ++i) {
+				const SCA_LogicCost *cost = costs[i].m_cost;
+				debugtxt = costs[i].m_object->GetName() + ":" + costs[i].m_owner->GetName();
+				debugDraw.RenderText2d(debugtxt, mt::vec2(xcoord + const_xindent, ycoord), white);
+
+				debugtxt = (boost::format("%5.2fms | worst %5.2fms") % (cost->GetTime() / cost->GetCalls() * 1000.0) %
+							(cost->GetWorstTime() * 1000.0)).str();
+				debugDraw.RenderText2d(debugtxt, mt::vec2(xcoord + const_xindent + 2 * profile_indent, ycoord), white);
+				ycoord += const_ysize;
+			}
+		}
 	}
 
 	if (m_flags & SHOW_RENDER_QUERIES) {
@@ -43,6 +43,7 @@
 #include <vector>
 
 struct TaskScheduler;
+struct TaskPool;
 class KX_Scene;
 class KX_Camera;
 class KX_ISystem;
@@ -104,7 +105,34 @@ public:
 		/// Automatic add debug properties to the debug list.
 		AUTO_ADD_DEBUG_PROPERTIES = (1 << 7),
 		/// Use override camera?
-		CAMERA_OVERRIDE = (1 << 8)
+		CAMERA_OVERRIDE = (1 << 8),
+		/** Update the scene graph and the physics of all scenes in parallel?
+		 * Only the stages not running python (scene graph and physics) are
+		 * dispatched on the task scheduler, logic is still proceeded scene
+		 * by scene.
+		 */
+		PARALLEL_SCENES = (1 << 9),
+		/// Update the independent node hierarchies of a scene graph in parallel?
+		PARALLEL_SCENEGRAPH = (1 << 10),
+		/// Synchronize the physics controllers and motion states in parallel?
+		PARALLEL_PHYSICS = (1 << 11),
+		/// Measure the cost of every logic brick and python component?
+		PROFILE_LOGIC = (1 << 12),
+		/// Compute the shadow casters of all the lights in parallel?
+		PARALLEL_SHADOWS = (1 << 13),
+		/** Skip the render of the shadow buffers when the light and the casters
+		 * inside its frustum didn't move since the last render? Changes not
+		 * moving or deforming the casters, like materials, are not detected.
+		 */
+		CACHE_SHADOWS = (1 << 14)
+	};
+
+	/// Data shared by all the scene tasks of a logic frame.
+	struct ScenePoolData
+	{
+		double curtime;
+		double timestep;
+		double framestep;
 	};
 
 private:
@@ -259,6 +287,11 @@ private:
 
 	/// Task scheduler for multi-threading
 	TaskScheduler *m_taskscheduler;
+	/// Task pool used to proceed scenes in parallel.
+	TaskPool *m_scenePool;
+	ScenePoolData m_scenePoolData;
+	/// Non suspended scenes proceeded in parallel during the current logic frame.
+	std::vector<KX_Scene *> m_parallelScenes;
 
 	/** Set scene's total pause duration for animations process.
 	 * This is done in a separate loop to get the proper state of each scenes.
@@ -304,8 +337,17 @@ private:
 	void ReplaceScheduledScenes(void);
 	void PostProcessScene(KX_Scene *scene);
 
+	/// Proceed logic, scene graph and physics of each scene one after the other.
+	void ProceedScenes(double timestep, double framestep);
+	/** Proceed logic of each scene one after the other, and the scene graph
+	 * and physics of all the scenes in parallel.
+	 */
+	void ProceedScenesParallel(double timestep, double framestep);
+
 	void BeginFrame();
 	void EndFrame();
+	/// Compute the average frame times and framerate and start the next profiling measurement.
+	void UpdateProfile();
 
 public:
 	KX_KetsjiEngine(KX_ISystem *system);
@@ -350,6 +392,10 @@ public:
 	/// returns true if an update happened to indicate -> Render
 	bool NextFrame();
 	void Render();
+	/** Replace the render of a frame when running without rasterizer output, update
+	 * the animations normally updated by the render and the profiling of the frame.
+	 */
+	void UpdateWithoutRender();
 	void RenderShadowBuffers(KX_Scene *scene);
 
 	void StartEngine();
@@ -37,6 +37,7 @@
 
 #include "KX_LightObject.h"
 #include "KX_Camera.h"
+#include "KX_Scene.h"
 #include "RAS_Rasterizer.h"
 #include "RAS_ICanvas.h"
 #include "RAS_ILightObject.h"
@@ -57,7 +58,9 @@ KX_LightObject::KX_LightObject(void *sgReplicationInfo, SG_Callbacks callbacks,
                                RAS_ILightObject *lightobj)
 	:KX_GameObject(sgReplicationInfo, callbacks),
 	m_rasterizer(rasterizer),
-	m_showShadowFrustum(false)
+	m_showShadowFrustum(false),
+	m_shadowCamera(nullptr),
+	m_shadowCached(false)
 {
 	m_lightobj = lightobj;
 	m_lightobj->m_scene = sgReplicationInfo;
@@ -74,6 +77,10 @@ KX_LightObject::~KX_LightObject()
 		delete(m_lightobj);
 	}
 
+	if (m_shadowCamera) {
+		m_shadowCamera->Release();
+	}
+
 	if (m_base) {
 		BKE_scene_base_unlink(m_blenderscene, m_base);
 		MEM_freeN(m_base);
@@ -92,6 +99,9 @@ EXP_Value *KX_LightObject::GetReplica()
 	if (m_base)
 		m_base = nullptr;
 
+	replica->m_shadowCamera = nullptr;
+	replica->InvalidateShadowCache();
+
 	return replica;
 }
 
@@ -110,6 +120,49 @@ void KX_LightObject::Update()
 	m_lightobj->Update(NodeGetWorldTransform(), !m_bVisible);
 }
 
+KX_Camera *KX_LightObject::GetShadowCamera()
+{
+	if (!m_shadowCamera) {
+		KX_Scene *scene = GetScene();
+		m_shadowCamera = new KX_Camera(scene, KX_Scene::m_callbacks, RAS_CameraData(), true);
+		m_shadowCamera->SetName("__shadow__cam__");
+	}
+
+	return m_shadowCamera;
+}
+
+bool KX_LightObject::UpdateShadowCache(const mt::mat4& frustumMatrix, const std::vector<KX_GameObject *>& casters)
+{
+	bool cached = m_shadowCached && casters == m_shadowCasters;
+	for (unsigned short i = 0; cached && i < 4; ++i) {
+		cached = (frustumMatrix.GetColumn(i) == m_shadowFrustumMatrix.GetColumn(i));
+	}
+
+	if (cached) {
+		for (KX_GameObject *gameobj : casters) {
+			// Deformed meshes change without moving their object.
+			if (gameobj->GetDeformer() || gameobj->GetSGNode()->IsDirty(SG_Node::DIRTY_CULLING)) {
+				cached = false;
+				break;
+			}
+		}
+	}
+
+	if (!cached) {
+		m_shadowCached = true;
+		m_shadowFrustumMatrix = frustumMatrix;
+		m_shadowCasters = casters;
+	}
+
+	return cached;
+}
+
+void KX_LightObject::InvalidateShadowCache()
+{
+	m_shadowCached = false;
+	m_shadowCasters.clear();
+}
+
 void KX_LightObject::UpdateScene(KX_Scene *kxscene)
 {
 	m_lightobj->m_scene = (void *)kxscene;
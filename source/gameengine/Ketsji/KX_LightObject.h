@@ -54,6 +54,13 @@ protected:
 
 	bool m_showShadowFrustum;
 
+	/// Camera used to render the shadow buffer, kept between the frames.
+	KX_Camera *m_shadowCamera;
+	/// The shadow buffer rendered with the following frustum and casters is still valid.
+	bool m_shadowCached;
+	mt::mat4 m_shadowFrustumMatrix;
+	std::vector<KX_GameObject *> m_shadowCasters;
+
 public:
 	KX_LightObject(void *sgReplicationInfo, SG_Callbacks callbacks, RAS_Rasterizer *rasterizer, RAS_ILightObject *lightobj);
 	virtual ~KX_LightObject();
@@ -70,6 +77,19 @@ public:
 	// Update rasterizer light settings.
 	void Update();
 
+	/// Return the camera used to render the shadow buffer, created at the first call.
+	KX_Camera *GetShadowCamera();
+
+	/** Return true if the shadow buffer rendered in a previous frame is still valid:
+	 * the frustum and the casters are the same and no caster moved or is deformed.
+	 * Otherwise the frustum and casters are stored for the render of the shadow buffer.
+	 * \param casters The objects inside the frustum, their DIRTY_CULLING flag
+	 * must be cleared after the update of the shadow caches of all the lights.
+	 */
+	bool UpdateShadowCache(const mt::mat4& frustumMatrix, const std::vector<KX_GameObject *>& casters);
+	/// Render the shadow buffer at the next update of the shadow cache.
+	void InvalidateShadowCache();
+
 	void UpdateScene(KX_Scene *kxscene);
 	virtual void SetLayer(int layer);
 
@@ -44,9 +44,12 @@ extern "C" {
 #  include "BKE_navmesh_conversion.h"
 
 #  include "BLI_alloca.h"
+#  include "BLI_task.h"
 }
 
 #include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+#include "KX_Scene.h"
 #include "KX_PyMath.h"
 #include "EXP_Value.h"
 #include "Recast.h"
@@ -96,14 +99,39 @@ inline void flipAxes(float vec[3])
 	std::swap(vec[1], vec[2]);
 }
 
+KX_NavMeshObject::PathQuery::PathQuery(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen)
+	:m_from(from),
+	m_to(to),
+	m_maxPathLen(maxPathLen),
+	m_done(false),
+#ifdef WITH_PYTHON
+	m_callback(nullptr),
+#endif  // WITH_PYTHON
+	m_startRef(0),
+	m_endRef(0),
+	m_cached(false)
+{
+}
+
+KX_NavMeshObject::PathQuery::~PathQuery()
+{
+#ifdef WITH_PYTHON
+	Py_XDECREF(m_callback);
+#endif  // WITH_PYTHON
+}
+
 KX_NavMeshObject::KX_NavMeshObject(void *sgReplicationInfo, SG_Callbacks callbacks)
 	:KX_GameObject(sgReplicationInfo, callbacks),
-	m_navMesh(nullptr)
+	m_navMesh(nullptr),
+	m_pathQueryBudget(0),
+	m_pathCacheSize(0),
+	m_pathCacheIndex(0)
 {
 }
 
 KX_NavMeshObject::~KX_NavMeshObject()
 {
+	FreeThreadNavMeshes();
 	if (m_navMesh) {
 		delete m_navMesh;
 	}
@@ -120,6 +148,10 @@ void KX_NavMeshObject::ProcessReplica()
 {
 	KX_GameObject::ProcessReplica();
 	m_navMesh = nullptr;
+	// The queries and thread navigation meshes belong to the original object.
+	m_pathQueries.clear();
+	m_threadNavMeshes.clear();
+	ClearPathCache();
 
 	if (!BuildNavMesh()) {
 		CM_FunctionError("unable to build navigation mesh");
@@ -307,6 +339,10 @@ bool KX_NavMeshObject::BuildVertIndArrays(float *&vertices, int& nverts,
 
 bool KX_NavMeshObject::BuildNavMesh()
 {
+	// The thread navigation meshes and cached corridors refer to the previous data.
+	FreeThreadNavMeshes();
+	ClearPathCache();
+
 	if (m_navMesh) {
 		delete m_navMesh;
 		m_navMesh = nullptr;
@@ -603,21 +639,179 @@ KX_NavMeshObject::PathType KX_NavMeshObject::FindPath(const mt::vec3& from, cons
 	if (sPolyRef && ePolyRef) {
 		dtStatPolyRef *polys = (dtStatPolyRef *)BLI_array_alloca(polys, maxPathLen);
 		const unsigned int npolys = m_navMesh->findPath(sPolyRef, ePolyRef, localfrom.Data(), localto.Data(), polys, maxPathLen);
-		if (npolys > 0) {
-			float(*points)[3] = (float(*)[3])BLI_array_alloca(points, maxPathLen);
-			const unsigned int pathLen = m_navMesh->findStraightPath(localfrom.Data(), localto.Data(), polys, npolys,
-					&points[0][0], maxPathLen);
-
-			path.resize(pathLen);
-			for (unsigned int i = 0; i < pathLen; ++i) {
-				mt::vec3 waypoint(points[i]);
-				flipAxes(waypoint);
-				path[i] = TransformToWorldCoords(waypoint);
+		FindStraightPath(m_navMesh, polys, npolys, localfrom, localto, maxPathLen, path);
+	}
+
+	return path;
+}
+
+void KX_NavMeshObject::FindStraightPath(dtStatNavMesh *navmesh, const dtStatPolyRef *polys, unsigned int npolys,
+		const mt::vec3& localfrom, const mt::vec3& localto, unsigned int maxPathLen, PathType& path) const
+{
+	if (npolys == 0) {
+		return;
+	}
+
+	float(*points)[3] = (float(*)[3])BLI_array_alloca(points, maxPathLen);
+	const unsigned int pathLen = navmesh->findStraightPath(localfrom.Data(), localto.Data(), polys, npolys,
+			&points[0][0], maxPathLen);
+
+	path.resize(pathLen);
+	for (unsigned int i = 0; i < pathLen; ++i) {
+		mt::vec3 waypoint(points[i]);
+		flipAxes(waypoint);
+		path[i] = TransformToWorldCoords(waypoint);
+	}
+}
+
+KX_NavMeshObject::PathQueryPtr KX_NavMeshObject::RequestPath(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen)
+{
+	PathQueryPtr query(new PathQuery(from, to, maxPathLen));
+	m_pathQueries.push_back(query);
+	GetScene()->AddPathQueryNavMesh(this);
+
+	return query;
+}
+
+bool KX_NavMeshObject::HasPathQueries() const
+{
+	return !m_pathQueries.empty();
+}
+
+void KX_NavMeshObject::ResolvePathQuery(PathQuery& query, int threadid) const
+{
+	dtStatNavMesh *navmesh = m_threadNavMeshes[threadid];
+
+	if (!query.m_cached) {
+		query.m_polys.resize(query.m_maxPathLen);
+		const unsigned int npolys = navmesh->findPath(query.m_startRef, query.m_endRef, query.m_localFrom.Data(),
+				query.m_localTo.Data(), query.m_polys.data(), query.m_maxPathLen);
+		query.m_polys.resize(npolys);
+	}
+
+	FindStraightPath(navmesh, query.m_polys.data(), query.m_polys.size(), query.m_localFrom, query.m_localTo,
+			query.m_maxPathLen, query.m_path);
+}
+
+static void resolve_path_query_thread_func(TaskPool *pool, void *taskdata, int threadid)
+{
+	const KX_NavMeshObject *navmesh = (KX_NavMeshObject *)BLI_task_pool_userdata(pool);
+	KX_NavMeshObject::PathQuery *query = (KX_NavMeshObject::PathQuery *)taskdata;
+	navmesh->ResolvePathQuery(*query, threadid);
+}
+
+void KX_NavMeshObject::ProceedPathQueries(std::vector<PathQueryPtr>& finishedQueries)
+{
+	if (m_pathQueries.empty()) {
+		return;
+	}
+
+	const unsigned int numQueries = (m_pathQueryBudget > 0) ?
+			std::min((unsigned int)m_pathQueryBudget, (unsigned int)m_pathQueries.size()) : m_pathQueries.size();
+
+	if (!m_navMesh) {
+		// Deliver empty paths.
+		for (unsigned int i = 0; i < numQueries; ++i) {
+			m_pathQueries[i]->m_done = true;
+			finishedQueries.push_back(m_pathQueries[i]);
+		}
+		m_pathQueries.erase(m_pathQueries.begin(), m_pathQueries.begin() + numQueries);
+		return;
+	}
+
+	TaskScheduler *scheduler = KX_GetActiveEngine()->GetTaskScheduler();
+
+	/* Each thread (including the one waiting for the pool) uses its own navigation mesh
+	 * as the search nodes are stored in the mesh, the polygons data are shared. */
+	if (m_threadNavMeshes.empty()) {
+		const unsigned int numThreads = BLI_task_scheduler_num_threads(scheduler) + 1;
+		m_threadNavMeshes.resize(numThreads);
+		for (dtStatNavMesh *& navmesh : m_threadNavMeshes) {
+			navmesh = new dtStatNavMesh();
+			navmesh->init(m_navMesh->getData(), m_navMesh->getDataSize(), false);
+		}
+	}
+
+	// The pool is bound to this object so the tasks find their thread navigation mesh.
+	TaskPool *pool = BLI_task_pool_create(scheduler, this);
+
+	for (unsigned int i = 0; i < numQueries; ++i) {
+		PathQuery *query = m_pathQueries[i].get();
+
+		query->m_localFrom = TransformToLocalCoords(query->m_from);
+		query->m_localTo = TransformToLocalCoords(query->m_to);
+		flipAxes(query->m_localFrom);
+		flipAxes(query->m_localTo);
+		query->m_startRef = m_navMesh->findNearestPoly(query->m_localFrom.Data(), polyPickExt);
+		query->m_endRef = m_navMesh->findNearestPoly(query->m_localTo.Data(), polyPickExt);
+
+		if (!query->m_startRef || !query->m_endRef) {
+			continue;
+		}
+
+		if (m_pathCacheSize > 0) {
+			const auto it = m_pathCacheMap.find((query->m_startRef << 16) | query->m_endRef);
+			if (it != m_pathCacheMap.end()) {
+				query->m_polys = m_pathCache[it->second].m_polys;
+				query->m_cached = true;
 			}
 		}
+
+		BLI_task_pool_push(pool, resolve_path_query_thread_func, query, false, TASK_PRIORITY_HIGH);
 	}
 
-	return path;
+	BLI_task_pool_work_and_wait(pool);
+	BLI_task_pool_free(pool);
+
+	for (unsigned int i = 0; i < numQueries; ++i) {
+		const PathQueryPtr& query = m_pathQueries[i];
+		if (m_pathCacheSize > 0 && !query->m_cached && !query->m_polys.empty()) {
+			AddPathCache(*query);
+		}
+		query->m_polys.clear();
+		query->m_done = true;
+		finishedQueries.push_back(query);
+	}
+
+	m_pathQueries.erase(m_pathQueries.begin(), m_pathQueries.begin() + numQueries);
+}
+
+void KX_NavMeshObject::FreeThreadNavMeshes()
+{
+	for (dtStatNavMesh *navmesh : m_threadNavMeshes) {
+		delete navmesh;
+	}
+	m_threadNavMeshes.clear();
+}
+
+void KX_NavMeshObject::ClearPathCache()
+{
+	m_pathCache.clear();
+	m_pathCacheMap.clear();
+	m_pathCacheIndex = 0;
+}
+
+void KX_NavMeshObject::AddPathCache(const PathQuery& query)
+{
+	const unsigned int key = (query.m_startRef << 16) | query.m_endRef;
+	if (m_pathCacheMap.find(key) != m_pathCacheMap.end()) {
+		// Already found by a previous query of the same frame.
+		return;
+	}
+
+	if (m_pathCache.size() < (unsigned int)m_pathCacheSize) {
+		m_pathCacheMap[key] = m_pathCache.size();
+		m_pathCache.push_back({key, query.m_polys});
+		return;
+	}
+
+	// Replace the oldest corridor.
+	PathCacheEntry& entry = m_pathCache[m_pathCacheIndex];
+	m_pathCacheMap.erase(entry.m_key);
+	entry.m_key = key;
+	entry.m_polys = query.m_polys;
+	m_pathCacheMap[key] = m_pathCacheIndex;
+	m_pathCacheIndex = (m_pathCacheIndex + 1) % m_pathCacheSize;
 }
 
 float KX_NavMeshObject::Raycast(const mt::vec3& from, const mt::vec3& to) const
@@ -674,11 +868,14 @@ PyTypeObject KX_NavMeshObject::Type = {
 };
 
 PyAttributeDef KX_NavMeshObject::Attributes[] = {
+	EXP_PYATTRIBUTE_INT_RW("pathQueryBudget", 0, INT_MAX, true, KX_NavMeshObject, m_pathQueryBudget),
+	EXP_PYATTRIBUTE_INT_RW_CHECK("pathCacheSize", 0, INT_MAX, true, KX_NavMeshObject, m_pathCacheSize, pyattr_check_pathCacheSize),
 	EXP_PYATTRIBUTE_NULL // Sentinel.
 };
 
 PyMethodDef KX_NavMeshObject::Methods[] = {
 	EXP_PYMETHODTABLE(KX_NavMeshObject, findPath),
+	EXP_PYMETHODTABLE(KX_NavMeshObject, findPathAsync),
 	EXP_PYMETHODTABLE(KX_NavMeshObject, raycast),
 	EXP_PYMETHODTABLE(KX_NavMeshObject, draw),
 	EXP_PYMETHODTABLE(KX_NavMeshObject, rebuild),
@@ -708,6 +905,31 @@ EXP_PYMETHODDEF_DOC(KX_NavMeshObject, findPath,
 	return pathList;
 }
 
+EXP_PYMETHODDEF_DOC(KX_NavMeshObject, findPathAsync,
+                    "findPathAsync(start, goal, callback): find path from start to goal points on worker threads\n"
+                    "callback is called with the path as list of points on a next frame\n")
+{
+	PyObject *ob_from, *ob_to, *callback;
+	if (!PyArg_ParseTuple(args, "OOO:findPathAsync", &ob_from, &ob_to, &callback)) {
+		return nullptr;
+	}
+	mt::vec3 from, to;
+	if (!PyVecTo(ob_from, from) || !PyVecTo(ob_to, to)) {
+		return nullptr;
+	}
+
+	if (!PyCallable_Check(callback)) {
+		PyErr_SetString(PyExc_TypeError, "navmesh.findPathAsync(start, goal, callback): KX_NavMeshObject, callback must be callable");
+		return nullptr;
+	}
+
+	PathQueryPtr query = RequestPath(from, to, MAX_PATH_LEN);
+	Py_INCREF(callback);
+	query->m_callback = callback;
+
+	Py_RETURN_NONE;
+}
+
 EXP_PYMETHODDEF_DOC(KX_NavMeshObject, raycast,
                     "raycast(start, goal): raycast from start to goal points\n"
                     "Returns hit factor)\n")
@@ -744,4 +966,12 @@ EXP_PYMETHODDEF_DOC_NOARGS(KX_NavMeshObject, rebuild,
 	Py_RETURN_NONE;
 }
 
+int KX_NavMeshObject::pyattr_check_pathCacheSize(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+	KX_NavMeshObject *self = static_cast<KX_NavMeshObject *>(self_v);
+	// The circular replacement expects a constant cache size.
+	self->ClearPathCache();
+	return 0;
+}
+
 #endif  // WITH_PYTHON
@@ -31,21 +31,84 @@
 #include "DetourStatNavMesh.h"
 #include "KX_GameObject.h"
 
+#include <memory>
+#include <unordered_map>
+
 class KX_NavMeshObject : public KX_GameObject
 {
 	Py_Header
 
+public:
+	using PathType = std::vector<mt::vec3, mt::simd_allocator<mt::vec3> >;
+
+	/// Path query resolved on the task scheduler at the end of the scene logic, see RequestPath.
+	class PathQuery : public mt::SimdClassAllocator
+	{
+	public:
+		PathQuery(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen);
+		~PathQuery();
+
+		mt::vec3 m_from;
+		mt::vec3 m_to;
+		unsigned int m_maxPathLen;
+		/// The resulting path, valid once m_done is true.
+		PathType m_path;
+		bool m_done;
+
+#ifdef WITH_PYTHON
+		/// Optional python function called with the path.
+		PyObject *m_callback;
+#endif  // WITH_PYTHON
+
+		// Data used while resolving the query.
+		mt::vec3 m_localFrom;
+		mt::vec3 m_localTo;
+		dtStatPolyRef m_startRef;
+		dtStatPolyRef m_endRef;
+		std::vector<dtStatPolyRef> m_polys;
+		bool m_cached;
+	};
+	using PathQueryPtr = std::shared_ptr<PathQuery>;
+
 protected:
 	dtStatNavMesh *m_navMesh;
 
+	/// Path queries waiting to be resolved, in request order.
+	std::vector<PathQueryPtr> m_pathQueries;
+	/** Navigation meshes sharing the data of m_navMesh with their own search
+	 * nodes, one per thread of the task scheduler.
+	 */
+	std::vector<dtStatNavMesh *> m_threadNavMeshes;
+	/// Maximum number of path queries resolved per frame, 0 for no limit.
+	int m_pathQueryBudget;
+
+	/// Polygon corridor found between two polygons.
+	struct PathCacheEntry
+	{
+		unsigned int m_key;
+		std::vector<dtStatPolyRef> m_polys;
+	};
+	/// Maximum number of recent corridors kept, 0 to disable the cache.
+	int m_pathCacheSize;
+	/// Cached corridors, replaced in circular order.
+	std::vector<PathCacheEntry> m_pathCache;
+	unsigned int m_pathCacheIndex;
+	/// Index in m_pathCache of a start and end polygons pair.
+	std::unordered_map<unsigned int, unsigned int> m_pathCacheMap;
+
+	void FreeThreadNavMeshes();
+	void ClearPathCache();
+	void AddPathCache(const PathQuery& query);
+	/// Find a path following the polygons corridor between the local start and end points.
+	void FindStraightPath(dtStatNavMesh *navmesh, const dtStatPolyRef *polys, unsigned int npolys, const mt::vec3& localfrom,
+			const mt::vec3& localto, unsigned int maxPathLen, PathType& path) const;
+
 	bool BuildVertIndArrays(float *&vertices, int& nverts,
 	                        unsigned short * &polys, int& npolys, unsigned short *&dmeshes,
 	                        float *&dvertices, int &ndvertsuniq, unsigned short * &dtris,
 	                        int& ndtris, int &vertsPerPoly);
 
 public:
-	using PathType = std::vector<mt::vec3, mt::simd_allocator<mt::vec3> >;
-
 	enum NavMeshRenderMode
 	{
 		RM_WALLS,
@@ -65,6 +128,18 @@ public:
 	dtStatNavMesh *GetNavMesh() const;
 
 	PathType FindPath(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen) const;
+	/** Queue a path query resolved at the end of the scene logic update,
+	 * the path is available to the requester the next frame.
+	 */
+	PathQueryPtr RequestPath(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen);
+	/** Resolve the pending path queries in the limit of the frame budget.
+	 * \param finishedQueries The resolved queries, their python callbacks are called by the caller.
+	 */
+	void ProceedPathQueries(std::vector<PathQueryPtr>& finishedQueries);
+	bool HasPathQueries() const;
+	/// Find the path of a query using the navigation mesh of a thread, can be called from any thread.
+	void ResolvePathQuery(PathQuery& query, int threadid) const;
+
 	float Raycast(const mt::vec3& from, const mt::vec3& to) const;
 
 	void DrawNavMesh(NavMeshRenderMode mode) const;
@@ -76,10 +151,13 @@ public:
 #ifdef WITH_PYTHON
 
 	EXP_PYMETHOD_DOC(KX_NavMeshObject, findPath);
+	EXP_PYMETHOD_DOC(KX_NavMeshObject, findPathAsync);
 	EXP_PYMETHOD_DOC(KX_NavMeshObject, raycast);
 	EXP_PYMETHOD_DOC(KX_NavMeshObject, draw);
 	EXP_PYMETHOD_DOC_NOARGS(KX_NavMeshObject, rebuild);
 
+	static int pyattr_check_pathCacheSize(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+
 #endif  // WITH_PYTHON
 };
 
@@ -28,9 +28,14 @@
 
 #include "KX_ObstacleSimulation.h"
 #include "KX_NavMeshObject.h"
+#include "KX_SteeringActuator.h"
 #include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
 #include "DNA_object_types.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
+
+#include <algorithm>
 
 namespace
 {
@@ -172,6 +177,11 @@ static float interpolateToi(float a, const float* dir, const float* toi, const i
 KX_ObstacleSimulation::KX_ObstacleSimulation(float levelHeight, bool enableVisualization)
 :	m_levelHeight(levelHeight)
 ,	m_enableVisualization(enableVisualization)
+,	m_gridValid(false)
+,	m_cellSize(1.0f)
+,	m_hashMask(0)
+,	m_maxObstacleRadius(0.0f)
+,	m_maxObstacleSpeed(0.0f)
 {
 
 }
@@ -199,6 +209,8 @@ KX_Obstacle* KX_ObstacleSimulation::CreateObstacle(KX_GameObject* gameobj)
 	obstacle->hhead = 0;
 
 	m_obstacles.push_back(obstacle);
+	// The obstacle is not in the grid until the next update.
+	m_gridValid = false;
 	return obstacle;
 }
 
@@ -248,6 +260,8 @@ void KX_ObstacleSimulation::DestroyObstacleForObj(KX_GameObject* gameobj)
 			m_obstacles[i] = m_obstacles.back();
 			m_obstacles.pop_back();
 			delete obstacle;
+			// The indices stored in the grid are invalid.
+			m_gridValid = false;
 		}
 		else
 			i++;
@@ -274,6 +288,155 @@ void KX_ObstacleSimulation::UpdateObstacles()
 			add_v2_v2v2(obs->pvel, obs->pvel, &obs->hvel[j * 2]);
 		mul_v2_fl(obs->pvel, 1.0f / VEL_HIST_SIZE);
 	}
+
+	BuildGrid();
+}
+
+/// Obstacles covering more cells are not inserted in the grid.
+static const int GRID_MAX_OBSTACLE_CELLS = 64;
+
+struct GridRange
+{
+	int minx;
+	int miny;
+	int maxx;
+	int maxy;
+};
+
+static inline unsigned int gridHash(int x, int y)
+{
+	return ((unsigned int)x * 73856093u) ^ ((unsigned int)y * 19349663u);
+}
+
+static GridRange gridRange(const mt::vec2& min, const mt::vec2& max, float cellSize)
+{
+	const float invCellSize = 1.0f / cellSize;
+	return {(int)floorf(min.x * invCellSize), (int)floorf(min.y * invCellSize),
+			(int)floorf(max.x * invCellSize), (int)floorf(max.y * invCellSize)};
+}
+
+static void obstacleBounds(const KX_Obstacle *obstacle, mt::vec2& min, mt::vec2& max)
+{
+	if (obstacle->m_shape == KX_OBSTACLE_SEGMENT) {
+		mt::vec3 p1 = obstacle->m_pos;
+		mt::vec3 p2 = obstacle->m_pos2;
+		if (obstacle->m_type == KX_OBSTACLE_NAV_MESH) {
+			const KX_NavMeshObject *navmeshobj = static_cast<KX_NavMeshObject *>(obstacle->m_gameObj);
+			p1 = navmeshobj->TransformToWorldCoords(p1);
+			p2 = navmeshobj->TransformToWorldCoords(p2);
+		}
+		min = mt::vec2(std::min(p1.x, p2.x), std::min(p1.y, p2.y));
+		max = mt::vec2(std::max(p1.x, p2.x), std::max(p1.y, p2.y));
+	}
+	else {
+		min = max = obstacle->m_pos.xy();
+	}
+
+	const mt::vec2 rad(obstacle->m_rad, obstacle->m_rad);
+	min -= rad;
+	max += rad;
+}
+
+void KX_ObstacleSimulation::BuildGrid()
+{
+	m_largeObstacles.clear();
+	m_maxObstacleRadius = 0.0f;
+	m_maxObstacleSpeed = 0.0f;
+
+	const unsigned int numObstacles = m_obstacles.size();
+	for (KX_Obstacle *obstacle : m_obstacles) {
+		m_maxObstacleRadius = std::max(m_maxObstacleRadius, obstacle->m_rad);
+		m_maxObstacleSpeed = std::max(m_maxObstacleSpeed, len_v2(obstacle->vel));
+	}
+
+	/* A cell contains a few agents and the distance traveled in a second by the fastest
+	 * one, as the queries extend to the distance reached before the max TOI. */
+	m_cellSize = std::max({m_maxObstacleRadius * 4.0f, m_maxObstacleSpeed, 1.0f});
+
+	unsigned int hashSize = 64;
+	while (hashSize < numObstacles * 2) {
+		hashSize <<= 1;
+	}
+	m_hashMask = hashSize - 1;
+	m_cellStarts.assign(hashSize + 1, 0);
+
+	std::vector<GridRange> ranges(numObstacles);
+	for (unsigned int i = 0; i < numObstacles; ++i) {
+		mt::vec2 min;
+		mt::vec2 max;
+		obstacleBounds(m_obstacles[i], min, max);
+
+		GridRange& range = ranges[i];
+		range = gridRange(min, max, m_cellSize);
+
+		const int width = range.maxx - range.minx + 1;
+		const int height = range.maxy - range.miny + 1;
+		if (width > GRID_MAX_OBSTACLE_CELLS || height > GRID_MAX_OBSTACLE_CELLS || width * height > GRID_MAX_OBSTACLE_CELLS) {
+			m_largeObstacles.push_back(i);
+			// Empty range.
+			range.maxx = range.minx - 1;
+			continue;
+		}
+
+		for (int y = range.miny; y <= range.maxy; ++y) {
+			for (int x = range.minx; x <= range.maxx; ++x) {
+				++m_cellStarts[gridHash(x, y) & m_hashMask];
+			}
+		}
+	}
+
+	// Compute the end of each cell, the cells are filled backward to their start.
+	for (unsigned int i = 1; i < hashSize; ++i) {
+		m_cellStarts[i] += m_cellStarts[i - 1];
+	}
+	m_cellStarts[hashSize] = m_cellStarts[hashSize - 1];
+	m_cellObstacles.resize(m_cellStarts[hashSize]);
+
+	// Iterate backward to keep the obstacle indices sorted in each cell.
+	for (int i = (int)numObstacles - 1; i >= 0; --i) {
+		const GridRange& range = ranges[i];
+		for (int y = range.miny; y <= range.maxy; ++y) {
+			for (int x = range.minx; x <= range.maxx; ++x) {
+				m_cellObstacles[--m_cellStarts[gridHash(x, y) & m_hashMask]] = i;
+			}
+		}
+	}
+
+	m_gridValid = true;
+}
+
+void KX_ObstacleSimulation::QueryObstacles(KX_Obstacle *activeObst, float radius, KX_Obstacles& obstacles) const
+{
+	const mt::vec2 pos = activeObst->m_pos.xy();
+	const mt::vec2 rad(radius, radius);
+	const GridRange range = gridRange(pos - rad, pos + rad, m_cellSize);
+
+	const int width = range.maxx - range.minx + 1;
+	const int height = range.maxy - range.miny + 1;
+	// Visiting more cells than the hash table size is slower than testing all the obstacles.
+	if (!m_gridValid || width > (int)m_hashMask || height > (int)m_hashMask || width * height > (int)m_hashMask) {
+		obstacles = m_obstacles;
+		return;
+	}
+
+	std::vector<unsigned int> indices(m_largeObstacles);
+	for (int y = range.miny; y <= range.maxy; ++y) {
+		for (int x = range.minx; x <= range.maxx; ++x) {
+			const unsigned int hash = gridHash(x, y) & m_hashMask;
+			indices.insert(indices.end(), m_cellObstacles.begin() + m_cellStarts[hash],
+			               m_cellObstacles.begin() + m_cellStarts[hash + 1]);
+		}
+	}
+
+	// Remove the obstacles found in several cells.
+	std::sort(indices.begin(), indices.end());
+	indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+	obstacles.clear();
+	obstacles.reserve(indices.size());
+	for (unsigned int index : indices) {
+		obstacles.push_back(m_obstacles[index]);
+	}
 }
 
 KX_Obstacle* KX_ObstacleSimulation::GetObstacle(KX_GameObject* gameobj)
@@ -292,6 +455,103 @@ void KX_ObstacleSimulation::AdjustObstacleVelocity(KX_Obstacle* activeObst, KX_N
 {
 }
 
+void KX_ObstacleSimulation::SolveObstacleVelocity(KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj,
+                                                  mt::vec3& velocity, float maxDeltaSpeed, float maxDeltaAngle)
+{
+}
+
+void KX_ObstacleSimulation::RequestObstacleVelocity(KX_SteeringActuator *actuator, KX_Obstacle *activeObst,
+                                                    KX_NavMeshObject *activeNavMeshObj, const mt::vec3& velocity,
+                                                    float maxDeltaSpeed, float maxDeltaAngle)
+{
+	m_velocityRequests.push_back({actuator, activeObst, activeNavMeshObj, velocity, maxDeltaSpeed, maxDeltaAngle});
+}
+
+struct ObstacleVelocityRange
+{
+	KX_ObstacleSimulation *m_simulation;
+	KX_ObstacleVelocityRequest **m_requests;
+	unsigned int m_count;
+};
+
+static void solve_obstacles_velocity_thread_func(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	const ObstacleVelocityRange *range = (ObstacleVelocityRange *)taskdata;
+	for (unsigned int i = 0; i < range->m_count; ++i) {
+		KX_ObstacleVelocityRequest *request = range->m_requests[i];
+		range->m_simulation->SolveObstacleVelocity(request->m_obstacle, request->m_navmesh, request->m_velocity,
+		                                           request->m_maxDeltaSpeed, request->m_maxDeltaAngle);
+	}
+}
+
+void KX_ObstacleSimulation::AdjustObstaclesVelocity()
+{
+	if (m_velocityRequests.empty()) {
+		return;
+	}
+
+	/* Solving writes in the agent obstacle, only the first request of each obstacle is
+	 * solved in parallel, the requests of agents using several steering actuators are
+	 * solved after in their original order. */
+	std::vector<KX_ObstacleVelocityRequest *> requests(m_velocityRequests.size());
+	for (unsigned int i = 0, size = m_velocityRequests.size(); i < size; ++i) {
+		requests[i] = &m_velocityRequests[i];
+	}
+	std::stable_sort(requests.begin(), requests.end(),
+	                 [](KX_ObstacleVelocityRequest *a, KX_ObstacleVelocityRequest *b) { return a->m_obstacle < b->m_obstacle; });
+
+	std::vector<KX_ObstacleVelocityRequest *> uniqueRequests;
+	std::vector<KX_ObstacleVelocityRequest *> duplicateRequests;
+	uniqueRequests.reserve(requests.size());
+	for (unsigned int i = 0, size = requests.size(); i < size; ++i) {
+		KX_ObstacleVelocityRequest *request = requests[i];
+		if (i > 0 && request->m_obstacle == requests[i - 1]->m_obstacle) {
+			duplicateRequests.push_back(request);
+		}
+		else {
+			// All the desired velocities must be set before solving.
+			vset(request->m_obstacle->dvel, request->m_velocity.x, request->m_velocity.y);
+			uniqueRequests.push_back(request);
+		}
+	}
+
+	TaskScheduler *scheduler = KX_GetActiveEngine()->GetTaskScheduler();
+	const unsigned int numThreads = BLI_task_scheduler_num_threads(scheduler);
+	const unsigned int count = uniqueRequests.size();
+	const unsigned int taskSize = std::max(8U, count / (numThreads * 4));
+
+	std::vector<ObstacleVelocityRange> ranges;
+	ranges.reserve(count / taskSize + 1);
+	for (unsigned int start = 0; start < count; start += taskSize) {
+		ranges.push_back({this, &uniqueRequests[start], std::min(taskSize, count - start)});
+	}
+
+	if (ranges.size() == 1) {
+		solve_obstacles_velocity_thread_func(nullptr, &ranges.front(), 0);
+	}
+	else {
+		// Solved during the logic update, the pool lives only for the unique requests.
+		TaskPool *pool = BLI_task_pool_create(scheduler, nullptr);
+		for (ObstacleVelocityRange& range : ranges) {
+			BLI_task_pool_push(pool, solve_obstacles_velocity_thread_func, &range, false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
+	}
+
+	for (KX_ObstacleVelocityRequest *request : duplicateRequests) {
+		vset(request->m_obstacle->dvel, request->m_velocity.x, request->m_velocity.y);
+		SolveObstacleVelocity(request->m_obstacle, request->m_navmesh, request->m_velocity,
+		                      request->m_maxDeltaSpeed, request->m_maxDeltaAngle);
+	}
+
+	for (KX_ObstacleVelocityRequest& request : m_velocityRequests) {
+		request.m_actuator->ApplySteering(request.m_velocity);
+	}
+
+	m_velocityRequests.clear();
+}
+
 void KX_ObstacleSimulation::DrawObstacles()
 {
 	if (!m_enableVisualization)
@@ -395,6 +655,12 @@ void KX_ObstacleSimulationTOI::AdjustObstacleVelocity(KX_Obstacle* activeObst, K
 
 	vset(activeObst->dvel, velocity.x, velocity.y);
 
+	SolveObstacleVelocity(activeObst, activeNavMeshObj, velocity, maxDeltaSpeed, maxDeltaAngle);
+}
+
+void KX_ObstacleSimulationTOI::SolveObstacleVelocity(KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj,
+                                                     mt::vec3& velocity, float maxDeltaSpeed, float maxDeltaAngle)
+{
 	//apply RVO
 	sampleRVO(activeObst, activeNavMeshObj, maxDeltaAngle);
 
@@ -411,6 +677,14 @@ void KX_ObstacleSimulationTOI::AdjustObstacleVelocity(KX_Obstacle* activeObst, K
 	velocity.y = vel[1];
 }
 
+float KX_ObstacleSimulationTOI::GetQueryRadius(KX_Obstacle *activeObst, float vmax) const
+{
+	/* The samples velocity is at most 1.5 * vmax, the relative velocity against an obstacle
+	 * is two times the sample velocity minus the agent and obstacle velocities. */
+	const float speed = 3.0f * vmax + len_v2(activeObst->vel) + m_maxObstacleSpeed;
+	return activeObst->m_rad + m_maxObstacleRadius + speed * m_maxToi;
+}
+
 ///////////*********TOI_rays**********/////////////////
 static const int AVOID_MAX_STEPS = 128;
 struct TOICircle
@@ -457,7 +731,9 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle* activeObst, KX_NavMes
 	const int iforw = m_maxSamples/2;
 	const float aoff = (float)iforw / (float)m_maxSamples;
 
-	size_t nobs = m_obstacles.size();
+	KX_Obstacles obstacles;
+	QueryObstacles(activeObst, GetQueryRadius(activeObst, vmax), obstacles);
+
 	for (int iter = 0; iter < m_maxSamples; ++iter)
 	{
 		// Calculate sample velocity
@@ -470,9 +746,8 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle* activeObst, KX_NavMes
 		// Find min time of impact and exit amongst all obstacles.
 		float tmin = m_maxToi;
 		float tmine = 0.0f;
-		for (int i = 0; i < nobs; ++i)
+		for (KX_Obstacle *ob : obstacles)
 		{
-			KX_Obstacle* ob = m_obstacles[i];
 			bool res = filterObstacle(activeObst, activeNavMeshObj, ob, m_levelHeight);
 			if (!res)
 				continue;
@@ -751,6 +1026,9 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle* activeObst, KX_NavMe
 	float* spos = new float[2*m_maxSamples];
 	int nspos = 0;
 
+	KX_Obstacles obstacles;
+	QueryObstacles(activeObst, GetQueryRadius(activeObst, vmax), obstacles);
+
 	if (!m_adaptive)
 	{
 		const float cvx = activeObst->dvel[0]*m_bias;
@@ -773,7 +1051,7 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle* activeObst, KX_NavMe
 				}
 			}
 		}
-		processSamples(activeObst, activeNavMeshObj, m_obstacles, m_levelHeight, vmax, spos, cs/2, 
+		processSamples(activeObst, activeNavMeshObj, obstacles, m_levelHeight, vmax, spos, cs/2, 
 			nspos,  activeObst->nvel, m_maxToi, m_velWeight, m_curVelWeight, m_collisionWeight, m_toiWeight);
 	}
 	else
@@ -808,7 +1086,7 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle* activeObst, KX_NavMe
 				}
 			}
 
-			processSamples(activeObst, activeNavMeshObj, m_obstacles, m_levelHeight, vmax, spos, cs/2,
+			processSamples(activeObst, activeNavMeshObj, obstacles, m_levelHeight, vmax, spos, cs/2,
 			               nspos,  res, m_maxToi, m_velWeight, m_curVelWeight, m_collisionWeight, m_toiWeight);
 
 			cs *= 0.5f;
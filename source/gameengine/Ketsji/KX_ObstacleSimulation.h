@@ -31,6 +31,7 @@
 
 class KX_GameObject;
 class KX_NavMeshObject;
+class KX_SteeringActuator;
 
 enum KX_OBSTACLE_TYPE
 {
@@ -65,6 +66,17 @@ struct KX_Obstacle : mt::SimdClassAllocator
 };
 typedef std::vector<KX_Obstacle*> KX_Obstacles;
 
+/// Velocity adjustment queued by a steering actuator, proceeded with all the others of the frame.
+struct KX_ObstacleVelocityRequest
+{
+	KX_SteeringActuator *m_actuator;
+	KX_Obstacle *m_obstacle;
+	KX_NavMeshObject *m_navmesh;
+	mt::vec3 m_velocity;
+	float m_maxDeltaSpeed;
+	float m_maxDeltaAngle;
+};
+
 class KX_ObstacleSimulation
 {
 protected:
@@ -73,7 +85,28 @@ protected:
 	float m_levelHeight;
 	bool m_enableVisualization;
 
+	/** Spatial hash of the obstacles rebuilt in UpdateObstacles, each cell of
+	 * m_cellSize lists the index of the obstacles overlapping it. Obstacles
+	 * covering too many cells are stored in m_largeObstacles and always returned.
+	 */
+	bool m_gridValid;
+	float m_cellSize;
+	unsigned int m_hashMask;
+	std::vector<unsigned int> m_cellStarts;
+	std::vector<unsigned int> m_cellObstacles;
+	std::vector<unsigned int> m_largeObstacles;
+	/// Maximum circle obstacle radius and speed, used to extend the agent queries.
+	float m_maxObstacleRadius;
+	float m_maxObstacleSpeed;
+
+	std::vector<KX_ObstacleVelocityRequest> m_velocityRequests;
+
 	KX_Obstacle* CreateObstacle(KX_GameObject* gameobj);
+	void BuildGrid();
+	/** Find the obstacles possibly reached by an agent in a radius around its position.
+	 * The obstacles are ordered as in m_obstacles.
+	 */
+	void QueryObstacles(KX_Obstacle *activeObst, float radius, KX_Obstacles& obstacles) const;
 public:
 	KX_ObstacleSimulation(float levelHeight, bool enableVisualization);
 	virtual ~KX_ObstacleSimulation();
@@ -88,7 +121,19 @@ public:
 	void UpdateObstacles();
 	virtual void AdjustObstacleVelocity(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, 
 	                                    mt::vec3& velocity, float maxDeltaSpeed,float maxDeltaAngle);
-
+	/** Compute the velocity of an agent from its desired velocity already set.
+	 * Only the agent obstacle is modified, it can be called for several agents in parallel.
+	 */
+	virtual void SolveObstacleVelocity(KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj,
+	                                   mt::vec3& velocity, float maxDeltaSpeed, float maxDeltaAngle);
+
+	/// Set the desired velocity of an agent and queue its adjustment for AdjustObstaclesVelocity.
+	void RequestObstacleVelocity(KX_SteeringActuator *actuator, KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj,
+	                             const mt::vec3& velocity, float maxDeltaSpeed, float maxDeltaAngle);
+	/** Adjust the velocity of all the queued agents on the engine task scheduler
+	 * and give the result back to their steering actuators.
+	 */
+	void AdjustObstaclesVelocity();
 };
 class KX_ObstacleSimulationTOI: public KX_ObstacleSimulation
 {
@@ -103,10 +148,14 @@ protected:
 
 	virtual void sampleRVO(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, 
 							const float maxDeltaAngle) = 0;
+	/// Radius around an agent of speed vmax containing all the obstacles reachable before m_maxToi.
+	float GetQueryRadius(KX_Obstacle *activeObst, float vmax) const;
 public:
 	KX_ObstacleSimulationTOI(float levelHeight, bool enableVisualization);
 	virtual void AdjustObstacleVelocity(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, 
 		mt::vec3& velocity, float maxDeltaSpeed,float maxDeltaAngle);
+	virtual void SolveObstacleVelocity(KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj,
+	                                   mt::vec3& velocity, float maxDeltaSpeed, float maxDeltaAngle);
 };
 
 class KX_ObstacleSimulationTOI_rays: public KX_ObstacleSimulationTOI
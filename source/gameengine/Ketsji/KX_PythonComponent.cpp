@@ -69,6 +69,7 @@ void KX_PythonComponent::ProcessReplica()
 	EXP_Value::ProcessReplica();
 	m_gameobj = nullptr;
 	m_init = false;
+	m_cost.Reset();
 }
 
 KX_GameObject *KX_PythonComponent::GetGameObject() const
@@ -113,6 +114,11 @@ void KX_PythonComponent::Update()
 	}
 }
 
+SCA_LogicCost& KX_PythonComponent::GetCost()
+{
+	return m_cost;
+}
+
 PyObject *KX_PythonComponent::py_component_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
 	KX_PythonComponent *comp = new KX_PythonComponent(type->tp_name);
@@ -26,6 +26,7 @@
 #ifdef WITH_PYTHON
 
 #include "EXP_Value.h"
+#include "SCA_LogicCost.h"
 
 class KX_GameObject;
 struct PythonComponent;
@@ -39,6 +40,8 @@ private:
 	KX_GameObject *m_gameobj;
 	std::string m_name;
 	bool m_init;
+	/// Cost counters of the update, updated only when the logic manager collects the costs.
+	SCA_LogicCost m_cost;
 
 public:
 	KX_PythonComponent(const std::string& name);
@@ -58,6 +61,8 @@ public:
 	void Start();
 	void Update();
 
+	SCA_LogicCost& GetCost();
+
 	static PyObject *py_component_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
 
 	// Attributes
@@ -23,7 +23,7 @@ void KX_PythonComponentManager::UnregisterObject(KX_GameObject *gameobj)
 	CM_ListRemoveIfFound(m_objects, gameobj);
 }
 
-void KX_PythonComponentManager::UpdateComponents()
+void KX_PythonComponentManager::UpdateComponents(bool costProfile)
 {
 	/* Update object components, we copy the object pointer in a second list to make
 	 * sure that we iterate on a list which will not be modified, indeed components
@@ -31,6 +31,6 @@ void KX_PythonComponentManager::UpdateComponents()
 	 */
 	const std::vector<KX_GameObject *> objects = m_objects;
 	for (KX_GameObject *gameobj : objects) {
-		gameobj->UpdateComponents();
+		gameobj->UpdateComponents(costProfile);
 	}
 }
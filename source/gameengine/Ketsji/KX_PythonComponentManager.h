@@ -17,7 +17,7 @@ public:
 	void RegisterObject(KX_GameObject *gameobj);
 	void UnregisterObject(KX_GameObject *gameobj);
 
-	void UpdateComponents();
+	void UpdateComponents(bool costProfile);
 };
 
 #endif  // __KX_PYTHON_COMPONENT_H__
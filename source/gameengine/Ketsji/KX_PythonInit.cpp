@@ -299,6 +299,123 @@ static PyObject *gPyGetProfileInfo(PyObject *)
 	return KX_GetActiveEngine()->GetPyProfileDict();
 }
 
+PyDoc_STRVAR(gPyGetMemoryInfo_doc,
+"getMemoryInfo()\n"
+"returns a dictionary with the memory and the number of blocks allocated by the guarded allocator"
+);
+static PyObject *gPyGetMemoryInfo(PyObject *)
+{
+	PyObject *dict = PyDict_New();
+
+	PyObject *val = PyLong_FromSize_t(MEM_get_memory_in_use());
+	PyDict_SetItemString(dict, "memory", val);
+	Py_DECREF(val);
+
+	val = PyLong_FromUnsignedLong(MEM_get_memory_blocks_in_use());
+	PyDict_SetItemString(dict, "blocks", val);
+	Py_DECREF(val);
+
+	val = PyLong_FromSize_t(MEM_get_peak_memory());
+	PyDict_SetItemString(dict, "peak", val);
+	Py_DECREF(val);
+
+	return dict;
+}
+
+PyDoc_STRVAR(gPyGetLogicProfile_doc,
+"getLogicProfile()\n"
+"returns True if the cost of the logic bricks and components is measured"
+);
+static PyObject *gPyGetLogicProfile(PyObject *)
+{
+	return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PROFILE_LOGIC));
+}
+
+PyDoc_STRVAR(gPySetLogicProfile_doc,
+"setLogicProfile(enable)\n"
+"enables or disables the measure of the cost of the logic bricks and components"
+);
+static PyObject *gPySetLogicProfile(PyObject *, PyObject *args)
+{
+	int enable;
+	if (!PyArg_ParseTuple(args, "p:setLogicProfile", &enable)) {
+		return nullptr;
+	}
+
+	KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PROFILE_LOGIC, (bool)enable);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyGetLogicCosts_doc,
+"getLogicCosts()\n"
+"returns a list of dictionaries with the cost of the logic bricks and components of all the scenes,\n"
+"sorted from the most to the least expensive"
+);
+static PyObject *gPyGetLogicCosts(PyObject *)
+{
+	std::vector<KX_Scene::LogicCost> costs;
+	for (KX_Scene *scene : KX_GetActiveEngine()->CurrentScenes()) {
+		scene->GetLogicCosts(costs);
+	}
+
+	std::sort(costs.begin(), costs.end(), [](const KX_Scene::LogicCost& cost1, const KX_Scene::LogicCost& cost2) {
+		return cost1.m_cost->GetTime() > cost2.m_cost->GetTime();
+	});
+
+	PyObject *list = PyList_New(costs.size());
+	for (unsigned int i = 0, size = costs.size(); i < size; ++i) {
+		const KX_Scene::LogicCost& cost = costs[i];
+		SCA_PythonController *controller = dynamic_cast<SCA_PythonController *>(cost.m_owner);
+
+		PyObject *item = PyDict_New();
+		PyObject *val;
+
+		val = PyUnicode_FromStdString(cost.m_object->GetName());
+		PyDict_SetItemString(item, "object", val);
+		Py_DECREF(val);
+		val = PyUnicode_FromStdString(cost.m_owner->GetName());
+		PyDict_SetItemString(item, "name", val);
+		Py_DECREF(val);
+		val = PyUnicode_FromString(cost.m_type);
+		PyDict_SetItemString(item, "type", val);
+		Py_DECREF(val);
+		if (controller) {
+			val = PyUnicode_FromStdString(controller->GetScriptName());
+			PyDict_SetItemString(item, "script", val);
+			Py_DECREF(val);
+		}
+		else {
+			PyDict_SetItemString(item, "script", Py_None);
+		}
+		val = PyLong_FromLong(cost.m_cost->GetCalls());
+		PyDict_SetItemString(item, "calls", val);
+		Py_DECREF(val);
+		val = PyFloat_FromDouble(cost.m_cost->GetTime() * 1000.0);
+		PyDict_SetItemString(item, "time", val);
+		Py_DECREF(val);
+		val = PyFloat_FromDouble(cost.m_cost->GetWorstTime() * 1000.0);
+		PyDict_SetItemString(item, "worstTime", val);
+		Py_DECREF(val);
+
+		PyList_SET_ITEM(list, i, item);
+	}
+
+	return list;
+}
+
+PyDoc_STRVAR(gPyResetLogicCosts_doc,
+"resetLogicCosts()\n"
+"resets the cost of the logic bricks and components of all the scenes"
+);
+static PyObject *gPyResetLogicCosts(PyObject *)
+{
+	for (KX_Scene *scene : KX_GetActiveEngine()->CurrentScenes()) {
+		scene->ResetLogicCosts();
+	}
+
+	Py_RETURN_NONE;
+}
+
 PyDoc_STRVAR(gPySendMessage_doc,
 "sendMessage(subject, [body, to, from])\n"
 "sends a message in same manner as a message actuator"
@@ -604,7 +721,7 @@ static PyObject *pyPrintStats(PyObject *,PyObject *,PyObject *)
 static PyObject *pyPrintExt(PyObject *,PyObject *,PyObject *)
 {
 	RAS_Rasterizer *rasterizer = KX_GetActiveEngine()->GetRasterizer();
-	if (rasterizer)
+	if (rasterizer && !rasterizer->IsHeadless())
 		rasterizer->PrintHardwareInfo();
 	else
 		CM_Error("no rasterizer detected for PrintGLInfo!");
@@ -763,6 +880,27 @@ static PyObject *gLibList(PyObject *, PyObject *args)
 	return list;
 }
 
+static PyObject *gLibGetMergeBudget(PyObject *)
+{
+	return PyFloat_FromDouble(KX_GetActiveEngine()->GetConverter()->GetMergeBudget());
+}
+
+static PyObject *gLibSetMergeBudget(PyObject *, PyObject *args)
+{
+	double budget;
+	if (!PyArg_ParseTuple(args, "d:LibSetMergeBudget", &budget)) {
+		return nullptr;
+	}
+
+	if (budget < 0.0) {
+		PyErr_SetString(PyExc_ValueError, "bge.logic.LibSetMergeBudget(budget): budget must be positive or zero");
+		return nullptr;
+	}
+
+	KX_GetActiveEngine()->GetConverter()->SetMergeBudget(budget);
+	Py_RETURN_NONE;
+}
+
 struct PyNextFrameState pynextframestate;
 static PyObject *gPyNextFrame(PyObject *)
 {
@@ -826,11 +964,18 @@ static struct PyMethodDef game_methods[] = {
 	{"PrintMemInfo", (PyCFunction)pyPrintStats, METH_NOARGS, (const char *)"Print engine statistics"},
 	{"NextFrame", (PyCFunction)gPyNextFrame, METH_NOARGS, (const char *)"Render next frame (if Python has control)"},
 	{"getProfileInfo", (PyCFunction)gPyGetProfileInfo, METH_NOARGS, gPyGetProfileInfo_doc},
+	{"getMemoryInfo", (PyCFunction)gPyGetMemoryInfo, METH_NOARGS, gPyGetMemoryInfo_doc},
+	{"getLogicProfile", (PyCFunction)gPyGetLogicProfile, METH_NOARGS, gPyGetLogicProfile_doc},
+	{"setLogicProfile", (PyCFunction)gPySetLogicProfile, METH_VARARGS, gPySetLogicProfile_doc},
+	{"getLogicCosts", (PyCFunction)gPyGetLogicCosts, METH_NOARGS, gPyGetLogicCosts_doc},
+	{"resetLogicCosts", (PyCFunction)gPyResetLogicCosts, METH_NOARGS, gPyResetLogicCosts_doc},
 	/* library functions */
 	{"LibLoad", (PyCFunction)gLibLoad, METH_VARARGS|METH_KEYWORDS, (const char *)""},
 	{"LibNew", (PyCFunction)gLibNew, METH_VARARGS, (const char *)""},
 	{"LibFree", (PyCFunction)gLibFree, METH_VARARGS, (const char *)""},
 	{"LibList", (PyCFunction)gLibList, METH_VARARGS, (const char *)""},
+	{"LibGetMergeBudget", (PyCFunction)gLibGetMergeBudget, METH_NOARGS, (const char *)"Gets the time spent per frame merging asynchronously loaded libraries"},
+	{"LibSetMergeBudget", (PyCFunction)gLibSetMergeBudget, METH_VARARGS, (const char *)"Sets the time spent per frame merging asynchronously loaded libraries"},
 	
 	{nullptr, (PyCFunction) nullptr, 0, nullptr }
 };
@@ -59,6 +59,7 @@
 #include "KX_Mesh.h"
 #include "SCA_IScene.h"
 #include "KX_LodManager.h"
+#include "KX_PythonComponent.h"
 #include "KX_CullingHandler.h"
 
 #include "RAS_Rasterizer.h"
@@ -69,11 +70,12 @@
 #include "RAS_BucketManager.h"
 
 #include "EXP_FloatValue.h"
+#include "SCA_ISensor.h"
 #include "SCA_IController.h"
 #include "SCA_IActuator.h"
 #include "SG_Node.h"
 #include "SG_Controller.h"
-#include "SG_Node.h"
+#include "SG_Familly.h"
 #include "DNA_group_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_property_types.h"
@@ -90,7 +92,9 @@
 #include "BL_ModifierDeformer.h"
 #include "BL_ShapeDeformer.h"
 #include "BL_DeformableGameObject.h"
+#include "BL_ArmatureObject.h"
 #include "KX_ObstacleSimulation.h"
+#include "KX_NavMeshObject.h"
 
 #ifdef WITH_BULLET
 #  include "KX_SoftBodyDeformer.h"
@@ -106,6 +110,7 @@
 
 #include "CM_Message.h"
 #include "CM_List.h"
+#include "CM_Profiler.h"
 
 static void *KX_SceneReplicationFunc(SG_Node *node, void *gameobj, void *scene)
 {
@@ -147,18 +152,21 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
                    Scene *scene,
 				   RAS_ICanvas *canvas,
 				   KX_NetworkMessageManager *messageManager) :
+	m_lifespanTime(0.0),
 	m_keyboardmgr(nullptr),
 	m_mousemgr(nullptr),
 	m_physicsEnvironment(0),
 	m_sceneName(sceneName),
 	m_activeCamera(nullptr),
 	m_overrideCullingCamera(nullptr),
+	m_removalDepth(0),
 	m_ueberExecutionPriority(0),
 	m_suspend(false),
 	m_suspendedDelta(0.0),
 	m_activityCulling(false),
 	m_dbvtCulling(false),
 	m_dbvtOcclusionRes(0),
+	m_boundsFrame(1),
 	m_blenderScene(scene),
 	m_previousAnimTime(0.0f),
 	m_isActivedHysteresis(false),
@@ -198,7 +206,9 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
 	m_bucketmanager = new RAS_BucketManager(textMaterial);
 	m_boundingBoxManager = new RAS_BoundingBoxManager();
 
-	m_animationPool = BLI_task_pool_create(KX_GetActiveEngine()->GetTaskScheduler(), &m_animationPoolData);
+	TaskScheduler *scheduler = KX_GetActiveEngine()->GetTaskScheduler();
+	m_animationPool = BLI_task_pool_create(scheduler, &m_animationPoolData);
+	m_animationPoolData.deformedObjects.resize(BLI_task_scheduler_num_threads(scheduler));
 
 #ifdef WITH_PYTHON
 	m_attrDict = nullptr;
@@ -217,10 +227,16 @@ KX_Scene::~KX_Scene()
 	 */
 	RemoveAllDebugProperties();
 
-	while (GetRootParentList()->GetCount() > 0) {
-		KX_GameObject *parentobj = GetRootParentList()->GetValue(0);
-		this->RemoveObject(parentobj);
+	while (!m_objectPools.empty()) {
+		DisableObjectPool(m_objectPools.begin()->first);
+	}
+
+	std::vector<KX_GameObject *> parentobjs;
+	parentobjs.reserve(m_parentlist->GetCount());
+	for (KX_GameObject *parentobj : m_parentlist) {
+		parentobjs.push_back(parentobj);
 	}
+	RemoveObjects(parentobjs);
 
 	if (m_obstacleSimulation) {
 		delete m_obstacleSimulation;
@@ -445,12 +461,7 @@ void KX_Scene::AddObjectDebugProperties(KX_GameObject *gameobj)
 
 void KX_Scene::RemoveNodeDestructObject(KX_GameObject *gameobj)
 {
-	if (NewRemoveObject(gameobj)) {
-		/* Object is not yet deleted because a reference is hanging somewhere.
-		 * This should not happen anymore since we use proxy object for Python. */
-		CM_Error("zombie object! name=" << gameobj->GetName());
-		BLI_assert(false);
-	}
+	NewRemoveObject(gameobj);
 }
 
 KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *gameobj)
@@ -807,8 +818,29 @@ bool KX_Scene::IsObjectInGroup(KX_GameObject *gameobj) const
 	return (m_groupGameObjects.empty() || m_groupGameObjects.find(gameobj) != m_groupGameObjects.end());
 }
 
+void KX_Scene::SetObjectLifespan(KX_GameObject *gameobj, float lifespan)
+{
+	if (lifespan > 0.0f) {
+		/* This convert the life from frames to sort-of seconds, hard coded 0.02 that assumes we have 50 frames per second
+		 * if you change this value, make sure you change it in KX_GameObject::pyattr_get_life property too. */
+		const double expiry = m_lifespanTime + lifespan * 0.02;
+		gameobj->SetLifespanEnd(expiry);
+		m_lifespanHeap.emplace_back(expiry, gameobj);
+		std::push_heap(m_lifespanHeap.begin(), m_lifespanHeap.end(), std::greater<ObjectLifespan>());
+	}
+	else {
+		gameobj->SetLifespanEnd(-1.0);
+	}
+}
+
 KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobj, KX_GameObject *referenceobj, float lifespan)
 {
+	const std::map<KX_GameObject *, std::vector<KX_GameObject *> >::iterator poolIt = m_objectPools.find(originalobj);
+	const bool pooled = (poolIt != m_objectPools.end());
+	if (pooled && !poolIt->second.empty()) {
+		return ReuseReplicaObject(originalobj, referenceobj, lifespan, poolIt->second);
+	}
+
 	m_logicHierarchicalGameObjects.clear();
 	m_map_gameobject_to_replica.clear();
 	m_groupGameObjects.clear();
@@ -818,18 +850,12 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobj, KX_GameObj
 	// Lets create a replica.
 	KX_GameObject *replica = AddNodeReplicaObject(nullptr, originalobj);
 
-	/* Add a timebomb to this object
-	 * lifespan of zero means 'this object lives forever'. */
-	if (lifespan > 0.0f) {
-		// For now, convert between so called frames and realtime.
-		m_tempObjectList.push_back(replica);
-		/* This convert the life from frames to sort-of seconds, hard coded 0.02 that assumes we have 50 frames per second
-		 * if you change this value, make sure you change it in KX_GameObject::pyattr_get_life property too. */
-		EXP_Value *fval = new EXP_FloatValue(lifespan * 0.02f);
-		replica->SetProperty("::timebomb", fval);
-		fval->Release();
+	if (pooled) {
+		m_pooledReplicas[replica] = originalobj;
 	}
 
+	SetObjectLifespan(replica, lifespan);
+
 	// Add to 'rootparent' list (this is the list of top hierarchy objects, updated each frame).
 	m_parentlist->Add(CM_AddRef(replica));
 
@@ -904,17 +930,295 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobj, KX_GameObj
 	return replica;
 }
 
+KX_GameObject *KX_Scene::ReuseReplicaObject(KX_GameObject *originalobj, KX_GameObject *referenceobj, float lifespan,
+                                            std::vector<KX_GameObject *>& pool)
+{
+	KX_GameObject *replica = pool.back();
+	pool.pop_back();
+
+	// The reference owned by the pool is given back to the object list.
+	m_objectlist->Add(replica);
+	m_parentlist->Add(CM_AddRef(replica));
+
+	if (replica->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+		AddAnimatedObject(replica);
+	}
+
+	if (originalobj->GetComponents()) {
+		m_componentManager.RegisterObject(replica);
+	}
+
+	if (m_obstacleSimulation && originalobj->GetBlenderObject()->gameflag & OB_HASOBSTACLE) {
+		m_obstacleSimulation->AddObstacleForObj(replica);
+	}
+
+	// Reset the properties values and register again the timers.
+	replica->ResetProperties(originalobj);
+	for (unsigned short i = 0, numprops = replica->GetPropertyCount(); i < numprops; ++i) {
+		EXP_Value *prop = replica->GetProperty(i);
+
+		if (prop->GetProperty("timer")) {
+			m_timemgr->AddTimeProperty(prop);
+		}
+	}
+
+	SetObjectLifespan(replica, lifespan);
+
+	// Place the replica like a new replica from the original object or at the reference object.
+	SG_Node *orgnode = originalobj->GetSGNode();
+	replica->NodeSetLocalScale(orgnode->GetLocalScale());
+	if (referenceobj) {
+		replica->NodeSetLocalPosition(referenceobj->NodeGetWorldPosition());
+		replica->NodeSetLocalOrientation(referenceobj->NodeGetWorldOrientation());
+		replica->NodeSetRelativeScale(referenceobj->GetSGNode()->GetRootSGParent()->GetLocalScale());
+		replica->SetLayer(referenceobj->GetLayer());
+	}
+	else {
+		replica->NodeSetLocalPosition(orgnode->GetLocalPosition());
+		replica->NodeSetLocalOrientation(orgnode->GetLocalOrientation());
+		replica->SetLayer(m_blenderScene->lay);
+	}
+	replica->GetSGNode()->UpdateWorldData();
+
+	PHY_IPhysicsController *ctrl = replica->GetPhysicsController();
+	if (ctrl) {
+		ctrl->RestorePhysics();
+		ctrl->RestoreDynamics();
+		ctrl->SetLinearVelocity(mt::zero3, false);
+		ctrl->SetAngularVelocity(mt::zero3, false);
+	}
+	replica->ActivateGraphicController(false);
+	replica->UpdateBounds(true);
+
+	if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES)) {
+		AddObjectDebugProperties(replica);
+	}
+
+	// The logic bricks are still linked, only restore the initial state.
+	replica->ResetState();
+
+	// Returned with a reference like AddReplicaObject.
+	return CM_AddRef(replica);
+}
+
+bool KX_Scene::ParkReplicaObject(KX_GameObject *gameobj)
+{
+	const std::map<KX_GameObject *, KX_GameObject *>::iterator it = m_pooledReplicas.find(gameobj);
+	if (it == m_pooledReplicas.end()) {
+		return false;
+	}
+
+	// Replicas parented or used as parent since their creation are removed with their hierarchy.
+	SG_Node *node = gameobj->GetSGNode();
+	if (node->GetSGParent() || !node->GetSGChildren().empty()) {
+		return false;
+	}
+
+	BeginObjectsRemoval();
+
+	RemoveObjectDebugProperties(gameobj);
+	gameobj->InvalidateProxy();
+
+	// Deactivate the controllers and unregister the sensors, the bricks stay linked for the next use.
+	gameobj->SetState(0);
+	for (SCA_IActuator *actuator : gameobj->GetActuators()) {
+		actuator->Deactivate();
+		actuator->SetActive(false);
+		actuator->RemoveAllEvents();
+	}
+
+	// Other objects must not follow a parked replica, they lose it as if it was deleted.
+	gameobj->UnlinkRegisteredClients();
+
+	for (unsigned short i = 0, numprops = gameobj->GetPropertyCount(); i < numprops; ++i) {
+		EXP_Value *propval = gameobj->GetProperty(i);
+		if (propval->GetProperty("timer")) {
+			m_timemgr->RemoveTimeProperty(propval);
+		}
+	}
+
+	gameobj->StopAllActions();
+	gameobj->SuspendPhysics(false);
+	if (gameobj->GetGraphicController()) {
+		gameobj->GetGraphicController()->Activate(false);
+	}
+
+	if (m_obstacleSimulation) {
+		m_obstacleSimulation->DestroyObstacleForObj(gameobj);
+	}
+
+	m_componentManager.UnregisterObject(gameobj);
+
+	m_rendererManager->InvalidateViewpoint(gameobj);
+
+	// The lists references are released at the end of the removal, the pool owns its own reference.
+	gameobj->SetDelayedRemoval(false);
+	gameobj->SetPendingRemoval(true);
+	m_parkedObjects.push_back(gameobj);
+	m_objectPools[it->second].push_back(CM_AddRef(gameobj));
+
+	EndObjectsRemoval();
+
+	return true;
+}
+
+bool KX_Scene::EnableObjectPool(KX_GameObject *gameobj, unsigned int size)
+{
+	switch (gameobj->GetGameObjectType()) {
+		case SCA_IObject::OBJ_CAMERA:
+		case SCA_IObject::OBJ_LIGHT:
+		case SCA_IObject::OBJ_TEXT:
+		case SCA_IObject::OBJ_NAVMESH:
+		{
+			// These objects are registered in other lists of the scene.
+			return false;
+		}
+	}
+
+	if (!gameobj->GetSGNode()->GetSGChildren().empty() || gameobj->IsDupliGroup()) {
+		return false;
+	}
+
+	std::vector<KX_GameObject *>& pool = m_objectPools[gameobj];
+	// Put aside the already parked replicas, AddReplicaObject must create new replicas.
+	std::vector<KX_GameObject *> parked;
+	parked.swap(pool);
+	pool.reserve(parked.size() + size);
+
+	for (unsigned int i = 0; i < size; ++i) {
+		KX_GameObject *replica = AddReplicaObject(gameobj, nullptr);
+		ParkReplicaObject(replica);
+		replica->Release();
+	}
+
+	pool.insert(pool.end(), parked.begin(), parked.end());
+
+	return true;
+}
+
+void KX_Scene::DisableObjectPool(KX_GameObject *gameobj)
+{
+	const std::map<KX_GameObject *, std::vector<KX_GameObject *> >::iterator it = m_objectPools.find(gameobj);
+	if (it == m_objectPools.end()) {
+		return;
+	}
+
+	const std::vector<KX_GameObject *> pool = std::move(it->second);
+	m_objectPools.erase(it);
+
+	for (KX_GameObject *replica : pool) {
+		if (replica->IsPendingRemoval()) {
+			// Parked during the current removal, the scene lists still own their references.
+			replica->SetPendingRemoval(false);
+			replica->Release();
+		}
+		else {
+			// Give back the pool reference to the object list, released by the normal removal.
+			m_objectlist->Add(replica);
+		}
+		RemoveObject(replica);
+	}
+
+	// The replicas in use are not reused anymore and removed normally.
+	for (std::map<KX_GameObject *, KX_GameObject *>::iterator rit = m_pooledReplicas.begin(); rit != m_pooledReplicas.end();) {
+		if (rit->second == gameobj) {
+			rit = m_pooledReplicas.erase(rit);
+		}
+		else {
+			++rit;
+		}
+	}
+}
+
+void KX_Scene::BeginObjectsRemoval()
+{
+	++m_removalDepth;
+}
+
+void KX_Scene::EndObjectsRemoval()
+{
+	if (--m_removalDepth > 0 || (m_removedObjects.empty() && m_parkedObjects.empty())) {
+		return;
+	}
+
+	const std::function<bool (KX_GameObject *)> isPending = [](KX_GameObject *gameobj) {
+		return gameobj->IsPendingRemoval();
+	};
+	const std::function<bool (KX_GameObject *)> releasePending = [](KX_GameObject *gameobj) {
+		if (gameobj->IsPendingRemoval()) {
+			// Never the last reference, it is kept by the removed or pool objects.
+			gameobj->Release();
+			return true;
+		}
+		return false;
+	};
+
+	m_animatedlist.erase(std::remove_if(m_animatedlist.begin(), m_animatedlist.end(), isPending), m_animatedlist.end());
+	m_euthanasyobjects.erase(std::remove_if(m_euthanasyobjects.begin(), m_euthanasyobjects.end(), isPending),
+	                         m_euthanasyobjects.end());
+
+	const std::vector<ObjectLifespan>::iterator lifespanIt = std::remove_if(m_lifespanHeap.begin(), m_lifespanHeap.end(),
+		[](const ObjectLifespan& lifespan) { return lifespan.second->IsPendingRemoval(); });
+	if (lifespanIt != m_lifespanHeap.end()) {
+		m_lifespanHeap.erase(lifespanIt, m_lifespanHeap.end());
+		std::make_heap(m_lifespanHeap.begin(), m_lifespanHeap.end(), std::greater<ObjectLifespan>());
+	}
+
+	m_objectlist->RemoveIf(releasePending);
+	m_parentlist->RemoveIf(releasePending);
+	m_inactivelist->RemoveIf(releasePending);
+	m_lightlist->RemoveIf(releasePending);
+	m_fontlist->RemoveIf(releasePending);
+	m_cameralist->RemoveIf(releasePending);
+
+	for (KX_GameObject *gameobj : m_parkedObjects) {
+		gameobj->SetPendingRemoval(false);
+	}
+	m_parkedObjects.clear();
+
+	std::vector<KX_GameObject *> removedObjects;
+	removedObjects.swap(m_removedObjects);
+	for (KX_GameObject *gameobj : removedObjects) {
+		if (gameobj->Release()) {
+			/* Object is not yet deleted because a reference is hanging somewhere.
+			 * This should not happen anymore since we use proxy object for Python. */
+			CM_Error("zombie object! name=" << gameobj->GetName());
+			BLI_assert(false);
+		}
+	}
+}
+
 void KX_Scene::RemoveObject(KX_GameObject *gameobj)
 {
+	// Already removed with its parent during the current removal.
+	if (gameobj->IsPendingRemoval()) {
+		return;
+	}
+
 	// Disconnect child from parent.
 	SG_Node *node = gameobj->GetSGNode();
 
 	if (node) {
+		BeginObjectsRemoval();
+
 		node->DisconnectFromParent();
 
 		// Recursively destruct.
 		node->Destruct();
+
+		EndObjectsRemoval();
+	}
+}
+
+void KX_Scene::RemoveObjects(const std::vector<KX_GameObject *>& objects)
+{
+	BeginObjectsRemoval();
+
+	for (KX_GameObject *gameobj : objects) {
+		RemoveObject(gameobj);
 	}
+
+	EndObjectsRemoval();
 }
 
 void KX_Scene::RemoveDupliGroup(KX_GameObject *gameobj)
@@ -930,11 +1234,18 @@ void KX_Scene::DelayedRemoveObject(KX_GameObject *gameobj)
 {
 	RemoveDupliGroup(gameobj);
 
-	CM_ListAddIfNotFound(m_euthanasyobjects, gameobj);
+	if (!gameobj->IsDelayedRemoval() && !gameobj->IsPendingRemoval()) {
+		gameobj->SetDelayedRemoval(true);
+		m_euthanasyobjects.push_back(gameobj);
+	}
 }
 
-bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
+void KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 {
+	// The parked replicas can't outlive their original object.
+	DisableObjectPool(gameobj);
+	m_pooledReplicas.erase(gameobj);
+
 	// Remove property from debug list.
 	RemoveObjectDebugProperties(gameobj);
 
@@ -1000,37 +1311,16 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 		m_obstacleSimulation->DestroyObstacleForObj(gameobj);
 	}
 
+	if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_NAVMESH) {
+		CM_ListRemoveIfFound(m_pathQueryNavMeshes, static_cast<KX_NavMeshObject *>(gameobj));
+	}
+
 	m_componentManager.UnregisterObject(gameobj);
 
 	gameobj->RemoveMeshes();
 
 	m_rendererManager->InvalidateViewpoint(gameobj);
 
-	bool ret = true;
-	if (m_lightlist->RemoveValue(gameobj)) {
-		ret = (gameobj->Release() != nullptr);
-	}
-	if (m_objectlist->RemoveValue(gameobj)) {
-		ret = (gameobj->Release() != nullptr);
-	}
-	if (m_parentlist->RemoveValue(gameobj)) {
-		ret = (gameobj->Release() != nullptr);
-	}
-	if (m_inactivelist->RemoveValue(gameobj)) {
-		ret = (gameobj->Release() != nullptr);
-	}
-	if (m_fontlist->RemoveValue(gameobj)) {
-		ret = (gameobj->Release() != nullptr);
-	}
-	if (m_cameralist->RemoveValue(gameobj)) {
-		ret = (gameobj->Release() != nullptr);
-	}
-
-	// WARNING: 'gameobj' maybe be freed now, only compare, don't access.
-	CM_ListRemoveIfFound(m_animatedlist, gameobj);
-	CM_ListRemoveIfFound(m_euthanasyobjects, gameobj);
-	CM_ListRemoveIfFound(m_tempObjectList, gameobj);
-
 	if (gameobj == m_activeCamera) {
 		m_activeCamera = nullptr;
 	}
@@ -1039,8 +1329,10 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 		m_overrideCullingCamera = nullptr;
 	}
 
-	// Return value will be nullptr if the object is actually deleted (all reference gone)
-	return ret;
+	/* The object is removed from all the scene lists at the end of the removal,
+	 * this reference is released last and must delete the object. */
+	gameobj->SetPendingRemoval(true);
+	m_removedObjects.push_back(CM_AddRef(gameobj));
 }
 
 KX_Camera *KX_Scene::GetActiveCamera()
@@ -1089,6 +1381,119 @@ void KX_Scene::PhysicsCullingCallback(KX_ClientObjectInfo *objectInfo, void *cul
 	info->m_objects.push_back(gameobj);
 }
 
+/// Range of bounding boxes updated by a task.
+struct BoundingBoxRange
+{
+	RAS_BoundingBoxList::const_iterator m_begin;
+	RAS_BoundingBoxList::const_iterator m_end;
+};
+
+static void update_bounding_boxes_thread_func(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	const BoundingBoxRange *range = (BoundingBoxRange *)taskdata;
+	for (RAS_BoundingBoxList::const_iterator it = range->m_begin; it != range->m_end; ++it) {
+		(*it)->Update(false);
+	}
+}
+
+/// Range of deformed objects updated by a task.
+struct DeformerRange
+{
+	std::vector<KX_GameObject *>::const_iterator m_begin;
+	std::vector<KX_GameObject *>::const_iterator m_end;
+};
+
+static void update_deformers_thread_func(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	const DeformerRange *range = (DeformerRange *)taskdata;
+	for (std::vector<KX_GameObject *>::const_iterator it = range->m_begin; it != range->m_end; ++it) {
+		/** Update all the deformer, not only per material.
+		 * One of the side effect is to clear some flags about AABB calculation.
+		 * like in KX_SoftBodyDeformer.
+		 */
+		(*it)->GetDeformer()->UpdateBuckets();
+	}
+}
+
+void KX_Scene::UpdateObjectBounds(KX_GameObject *gameobj)
+{
+	if (gameobj->GetDeformer()) {
+		/** Update all the deformer, not only per material.
+		 * One of the side effect is to clear some flags about AABB calculation.
+		 * like in KX_SoftBodyDeformer.
+		 */
+		gameobj->GetDeformer()->UpdateBuckets();
+	}
+	// Update the object bounding volume box.
+	gameobj->UpdateBounds(false);
+
+	gameobj->SetBoundsFrame(m_boundsFrame);
+}
+
+void KX_Scene::UpdateObjectsBounds()
+{
+	++m_boundsFrame;
+
+	TaskScheduler *scheduler = KX_GetActiveEngine()->GetTaskScheduler();
+	const unsigned int numThreads = BLI_task_scheduler_num_threads(scheduler);
+
+	/* Mesh bounding boxes iterate over all the modified vertices, it is the expensive part
+	 * and each bounding box is independent, update them in parallel. */
+	const RAS_BoundingBoxList& boundingBoxes = m_boundingBoxManager->GetActiveBoundingBoxList();
+	const unsigned int boxTaskSize = std::max(8u, (unsigned int)boundingBoxes.size() / (numThreads * 4));
+
+	std::vector<BoundingBoxRange> boxRanges;
+	for (RAS_BoundingBoxList::const_iterator it = boundingBoxes.begin(), end = boundingBoxes.end(); it != end;) {
+		const RAS_BoundingBoxList::const_iterator rangeEnd = ((unsigned int)(end - it) > boxTaskSize) ? it + boxTaskSize : end;
+		boxRanges.push_back({it, rangeEnd});
+		it = rangeEnd;
+	}
+
+	/* The skin deformers of an armature only read its pose once it is evaluated,
+	 * evaluate it here so the deformers are independent and updated in parallel. */
+	std::vector<KX_GameObject *> deformedObjects;
+	for (KX_GameObject *gameobj : m_objectlist) {
+		if (!gameobj->GetDeformer()) {
+			continue;
+		}
+
+		KX_GameObject *parent = gameobj->GetParent();
+		if (parent && parent->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+			static_cast<BL_ArmatureObject *>(parent)->ApplyPose();
+		}
+		deformedObjects.push_back(gameobj);
+	}
+
+	const unsigned int deformerTaskSize = std::max(1u, (unsigned int)deformedObjects.size() / (numThreads * 4));
+
+	std::vector<DeformerRange> deformerRanges;
+	for (std::vector<KX_GameObject *>::const_iterator it = deformedObjects.begin(), end = deformedObjects.end(); it != end;) {
+		const std::vector<KX_GameObject *>::const_iterator rangeEnd = ((unsigned int)(end - it) > deformerTaskSize) ? it + deformerTaskSize : end;
+		deformerRanges.push_back({it, rangeEnd});
+		it = rangeEnd;
+	}
+
+	TaskPool *pool = BLI_task_pool_create(scheduler, nullptr);
+	for (BoundingBoxRange& range : boxRanges) {
+		BLI_task_pool_push(pool, update_bounding_boxes_thread_func, &range, false, TASK_PRIORITY_HIGH);
+	}
+	for (DeformerRange& range : deformerRanges) {
+		BLI_task_pool_push(pool, update_deformers_thread_func, &range, false, TASK_PRIORITY_HIGH);
+	}
+	BLI_task_pool_work_and_wait(pool);
+	BLI_task_pool_free(pool);
+
+	/* Copying the bounds to the graphic controller updates the physics broadphase,
+	 * which is not thread safe. */
+	for (KX_GameObject *gameobj : m_objectlist) {
+		// Update the object bounding volume box.
+		gameobj->UpdateBounds(false);
+		gameobj->SetBoundsFrame(m_boundsFrame);
+	}
+
+	m_boundingBoxManager->ClearModified();
+}
+
 void KX_Scene::CalculateVisibleMeshes(std::vector<KX_GameObject *>& objects, KX_Camera *cam, int layer)
 {
 	if (!cam->GetFrustumCulling()) {
@@ -1104,8 +1509,6 @@ void KX_Scene::CalculateVisibleMeshes(std::vector<KX_GameObject *>& objects, KX_
 
 void KX_Scene::CalculateVisibleMeshes(std::vector<KX_GameObject *>& objects, const SG_Frustum& frustum, int layer)
 {
-	m_boundingBoxManager->Update(false);
-
 	bool dbvt_culling = false;
 	if (m_dbvtCulling) {
 		for (KX_GameObject *gameobj : m_objectlist) {
@@ -1113,15 +1516,10 @@ void KX_Scene::CalculateVisibleMeshes(std::vector<KX_GameObject *>& objects, con
 			/* Reset KX_GameObject m_culled to true before doing culling
 			 * since DBVT culling will only set it to false.
 			 */
-			if (gameobj->GetDeformer()) {
-				/** Update all the deformer, not only per material.
-				 * One of the side effect is to clear some flags about AABB calculation.
-				 * like in KX_SoftBodyDeformer.
-				 */
-				gameobj->GetDeformer()->UpdateBuckets();
+			// Objects added since the last bounds update.
+			if (gameobj->GetBoundsFrame() != m_boundsFrame) {
+				UpdateObjectBounds(gameobj);
 			}
-			// Update the object bounding volume box.
-			gameobj->UpdateBounds(false);
 		}
 
 		// Test culling through Bullet, get the clip planes.
@@ -1133,25 +1531,78 @@ void KX_Scene::CalculateVisibleMeshes(std::vector<KX_GameObject *>& objects, con
 		dbvt_culling = m_physicsEnvironment->CullingTest(PhysicsCullingCallback, &info, planes, m_dbvtOcclusionRes, viewport, matrix);
 	}
 	if (!dbvt_culling) {
-		KX_CullingHandler handler(objects, frustum);
+		KX_CullingHandler handler(objects, frustum, true);
 		for (KX_GameObject *gameobj : m_objectlist) {
 			if (gameobj->UseCulling() && gameobj->GetVisible() && (layer == 0 || gameobj->GetLayer() & layer)) {
-				if (gameobj->GetDeformer()) {
-					/** Update all the deformer, not only per material.
-					 * One of the side effect is to clear some flags about AABB calculation.
-					 * like in KX_SoftBodyDeformer.
-					 */
-					gameobj->GetDeformer()->UpdateBuckets();
+				// Objects added since the last bounds update.
+				if (gameobj->GetBoundsFrame() != m_boundsFrame) {
+					UpdateObjectBounds(gameobj);
 				}
-				// Update the object bounding volume box.
-				gameobj->UpdateBounds(false);
 
 				handler.Process(gameobj);
 			}
 		}
+
+		handler.Cull();
 	}
+}
 
-	m_boundingBoxManager->ClearModified();
+static void cull_pass_objects(EXP_ListValue<KX_GameObject> *objectlist, KX_Scene::CullingPass& pass)
+{
+	// The culling state is shared by all the passes, it is set once all the passes are culled.
+	KX_CullingHandler handler(pass.m_objects, pass.m_frustum, false);
+	for (KX_GameObject *gameobj : objectlist) {
+		if (gameobj->UseCulling() && gameobj->GetVisible() && (pass.m_layer == 0 || gameobj->GetLayer() & pass.m_layer)) {
+			handler.Process(gameobj);
+		}
+	}
+
+	handler.Cull();
+}
+
+static void cull_pass_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+{
+	EXP_ListValue<KX_GameObject> *objectlist = (EXP_ListValue<KX_GameObject> *)BLI_task_pool_userdata(pool);
+	cull_pass_objects(objectlist, *(KX_Scene::CullingPass *)taskdata);
+}
+
+void KX_Scene::CalculateVisibleMeshes(std::vector<CullingPass>& passes, bool parallel)
+{
+	if (m_dbvtCulling) {
+		for (CullingPass& pass : passes) {
+			CalculateVisibleMeshes(pass.m_objects, pass.m_frustum, pass.m_layer);
+		}
+	}
+	else {
+		// Objects added since the last bounds update, updated once for all the passes.
+		for (KX_GameObject *gameobj : m_objectlist) {
+			if (gameobj->GetBoundsFrame() != m_boundsFrame) {
+				UpdateObjectBounds(gameobj);
+			}
+		}
+
+		if (!parallel || passes.size() < 2) {
+			for (CullingPass& pass : passes) {
+				cull_pass_objects(m_objectlist, pass);
+			}
+		}
+		else {
+			TaskPool *pool = BLI_task_pool_create(KX_GetActiveEngine()->GetTaskScheduler(), m_objectlist);
+			for (CullingPass& pass : passes) {
+				BLI_task_pool_push(pool, cull_pass_thread_func, &pass, false, TASK_PRIORITY_HIGH);
+			}
+			BLI_task_pool_work_and_wait(pool);
+			BLI_task_pool_free(pool);
+		}
+	}
+
+	/* The objects visible in any pass are not culled for the animations update,
+	 * e.g an armature only visible in a shadow must update its pose. */
+	for (CullingPass& pass : passes) {
+		for (KX_GameObject *gameobj : pass.m_objects) {
+			gameobj->SetCulled(false);
+		}
+	}
 }
 
 void KX_Scene::DrawDebug(RAS_DebugDraw& debugDraw, const std::vector<KX_GameObject *>& objects,
@@ -1240,92 +1691,209 @@ void KX_Scene::RenderDebugProperties(RAS_DebugDraw& debugDraw, int xindent, int
 	}
 }
 
-void KX_Scene::LogicBeginFrame(double curtime, double framestep)
+void KX_Scene::GetLogicCosts(std::vector<LogicCost>& costs)
 {
-	// Have a look at temp objects.
-	for (KX_GameObject *gameobj : m_tempObjectList) {
-		EXP_FloatValue *propval = static_cast<EXP_FloatValue *>(gameobj->GetProperty("::timebomb"));
+	for (KX_GameObject *gameobj : m_objectlist) {
+		for (SCA_ISensor *sensor : gameobj->GetSensors()) {
+			if (sensor->GetCost().GetCalls() > 0) {
+				costs.push_back({gameobj, sensor, "sensor", &sensor->GetCost()});
+			}
+		}
+		for (SCA_IController *controller : gameobj->GetControllers()) {
+			if (controller->GetCost().GetCalls() > 0) {
+				costs.push_back({gameobj, controller, "controller", &controller->GetCost()});
+			}
+		}
+		for (SCA_IActuator *actuator : gameobj->GetActuators()) {
+			if (actuator->GetCost().GetCalls() > 0) {
+				costs.push_back({gameobj, actuator, "actuator", &actuator->GetCost()});
+			}
+		}
 
-		if (propval) {
-			const float timeleft = propval->GetNumber() - framestep;
+#ifdef WITH_PYTHON
+		EXP_ListValue<KX_PythonComponent> *components = gameobj->GetComponents();
+		if (components) {
+			for (KX_PythonComponent *component : components) {
+				if (component->GetCost().GetCalls() > 0) {
+					costs.push_back({gameobj, component, "component", &component->GetCost()});
+				}
+			}
+		}
+#endif  // WITH_PYTHON
+	}
+}
 
-			if (timeleft > 0) {
-				propval->SetFloat(timeleft);
+void KX_Scene::ResetLogicCosts()
+{
+	for (EXP_ListValue<KX_GameObject> *list : {m_objectlist, m_inactivelist}) {
+		for (KX_GameObject *gameobj : list) {
+			for (SCA_ISensor *sensor : gameobj->GetSensors()) {
+				sensor->GetCost().Reset();
 			}
-			else {
-				// Remove obj, remove the object from tempObjectList in NewRemoveObject only.
-				DelayedRemoveObject(gameobj);
+			for (SCA_IController *controller : gameobj->GetControllers()) {
+				controller->GetCost().Reset();
 			}
+			for (SCA_IActuator *actuator : gameobj->GetActuators()) {
+				actuator->GetCost().Reset();
+			}
+
+#ifdef WITH_PYTHON
+			EXP_ListValue<KX_PythonComponent> *components = gameobj->GetComponents();
+			if (components) {
+				for (KX_PythonComponent *component : components) {
+					component->GetCost().Reset();
+				}
+			}
+#endif  // WITH_PYTHON
 		}
-		else {
-			// All object is the tempObjectList should have a clock.
-			BLI_assert(false);
-		}
 	}
+}
+
+void KX_Scene::LogicBeginFrame(double curtime, double framestep)
+{
+	CM_ProfileScope profileScope("logic");
+	if (profileScope.IsActive()) {
+		profileScope.SetName(GetName(), "LogicBeginFrame");
+	}
+
+	m_lifespanTime += framestep;
+
+	// Remove the objects at the end of their lifespan, the earliest are on top of the heap.
+	while (!m_lifespanHeap.empty() && m_lifespanHeap.front().first <= m_lifespanTime) {
+		KX_GameObject *gameobj = m_lifespanHeap.front().second;
+		std::pop_heap(m_lifespanHeap.begin(), m_lifespanHeap.end(), std::greater<ObjectLifespan>());
+		m_lifespanHeap.pop_back();
+
+		DelayedRemoveObject(gameobj);
+	}
+
+	m_logicmgr->SetCostProfile(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PROFILE_LOGIC));
 	m_logicmgr->BeginFrame(curtime, framestep);
 }
 
+double KX_Scene::GetLifespanTime() const
+{
+	return m_lifespanTime;
+}
+
 void KX_Scene::AddAnimatedObject(KX_GameObject *gameobj)
 {
 	CM_ListAddIfNotFound(m_animatedlist, gameobj);
 }
 
-static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+static bool armature_needs_update(KX_GameObject *gameobj)
 {
-	KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData *)BLI_task_pool_userdata(pool);
-	double curtime = data->curtime;
+	// Check the children meshes to see if we need to bother with a more expensive pose update.
+	const std::vector<KX_GameObject *> children = gameobj->GetChildren();
+
+	bool has_mesh = false, has_non_mesh = false;
+
+	// Check for meshes that haven't been culled
+	for (KX_GameObject *child : children) {
+		if (!child->GetCulled()) {
+			return true;
+		}
+
+		if (child->GetMeshList().empty()) {
+			has_non_mesh = true;
+		}
+		else {
+			has_mesh = true;
+		}
+	}
+
+	// If we didn't find a non-culled mesh, check to see
+	// if we even have any meshes, and update if this
+	// armature has only non-mesh children.
+	return (!has_mesh && has_non_mesh);
+}
+
+static void update_deformer(KX_Scene::AnimationPoolData *data, KX_GameObject *gameobj, int threadid)
+{
+	if (gameobj->GetDeformer()->Update()) {
+		data->deformedObjects[threadid].push_back(gameobj);
+	}
+}
 
+static void update_deformer_thread_func(TaskPool *pool, void *taskdata, int threadid)
+{
+	KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData *)BLI_task_pool_userdata(pool);
 	KX_GameObject *gameobj = (KX_GameObject *)taskdata;
 
-	// Non-armature updates are fast enough, so just update them
-	bool needs_update = gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE;
+	CM_ProfileScope profileScope("animation");
+	if (profileScope.IsActive()) {
+		profileScope.SetName(gameobj->GetName(), "Deformer");
+	}
 
-	if (!needs_update) {
-		// If we got here, we're looking to update an armature, so check its children meshes
-		// to see if we need to bother with a more expensive pose update
-		const std::vector<KX_GameObject *> children = gameobj->GetChildren();
+	update_deformer(data, gameobj, threadid);
+}
 
-		bool has_mesh = false, has_non_mesh = false;
+static void update_armature_thread_func(TaskPool *pool, void *taskdata, int threadid)
+{
+	KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData *)BLI_task_pool_userdata(pool);
+	BL_ArmatureObject *armature = (BL_ArmatureObject *)taskdata;
 
-		// Check for meshes that haven't been culled
-		for (KX_GameObject *child : children) {
-			if (!child->GetCulled()) {
-				needs_update = true;
-				break;
-			}
+	CM_ProfileScope profileScope("animation");
+	if (profileScope.IsActive()) {
+		profileScope.SetName(armature->GetName(), "Armature");
+	}
 
-			if (child->GetMeshList().empty()) {
-				has_non_mesh = true;
-			}
-			else {
-				has_mesh = true;
-			}
+	const bool needs_update = armature_needs_update(armature);
+
+	// If the armature is culled, then we manage only the animation time and end of its animations.
+	armature->UpdateActionManager(data->curtime, needs_update);
+
+	if (!needs_update) {
+		return;
+	}
+
+	/* Evaluate the pose once here, the skin deformers of the children then only read it
+	 * and are updated in separate tasks, the last one in this task. */
+	KX_GameObject *lastChild = nullptr;
+	for (KX_GameObject *child : armature->GetChildren()) {
+		if (!child->GetDeformer()) {
+			continue;
 		}
 
-		// If we didn't find a non-culled mesh, check to see
-		// if we even have any meshes, and update if this
-		// armature has only non-mesh children.
-		if (!needs_update && !has_mesh && has_non_mesh) {
-			needs_update = true;
+		if (lastChild) {
+			BLI_task_pool_push(pool, update_deformer_thread_func, lastChild, false, TASK_PRIORITY_HIGH);
 		}
+		else {
+			armature->ApplyPose();
+		}
+		lastChild = child;
 	}
 
-	// If the object is a culled armature, then we manage only the animation time and end of its animations.
-	gameobj->UpdateActionManager(curtime, needs_update);
+	if (lastChild) {
+		update_deformer(data, lastChild, threadid);
+	}
+}
+
+static void update_anim_thread_func(TaskPool *pool, void *taskdata, int threadid)
+{
+	KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData *)BLI_task_pool_userdata(pool);
+	const double curtime = data->curtime;
+	const KX_Scene::AnimationChunk *chunk = (KX_Scene::AnimationChunk *)taskdata;
+
+	CM_ProfileScope profileScope("animation", "Objects");
+
+	// Non-armature updates are fast enough, so just update them
+	for (unsigned int i = 0; i < chunk->count; ++i) {
+		KX_GameObject *gameobj = chunk->objects[i];
+
+		gameobj->UpdateActionManager(curtime, true);
 
-	if (needs_update) {
-		const std::vector<KX_GameObject *> children = gameobj->GetChildren();
 		KX_GameObject *parent = gameobj->GetParent();
 
 		// Only do deformers here if they are not parented to an armature, otherwise the armature will
 		// handle updating its children
 		if (gameobj->GetDeformer() && (!parent || parent->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE)) {
-			gameobj->GetDeformer()->Update();
+			update_deformer(data, gameobj, threadid);
 		}
 
-		for (KX_GameObject *child : children) {
+		for (KX_GameObject *child : gameobj->GetChildren()) {
 			if (child->GetDeformer()) {
-				child->GetDeformer()->Update();
+				update_deformer(data, child, threadid);
 			}
 		}
 	}
@@ -1333,6 +1901,11 @@ static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(t
 
 void KX_Scene::UpdateAnimations(double curtime, bool restrict)
 {
+	CM_ProfileScope profileScope("animation");
+	if (profileScope.IsActive()) {
+		profileScope.SetName(GetName(), "UpdateAnimations");
+	}
+
 	if (restrict) {
 		const double animTimeStep = 1.0 / m_blenderScene->r.frs_sec;
 
@@ -1348,35 +1921,93 @@ void KX_Scene::UpdateAnimations(double curtime, bool restrict)
 	}
 
 	m_animationPoolData.curtime = curtime;
+	m_animationObjects.clear();
+	m_animationChunks.clear();
 
+	/* Armatures get one task each, their pose evaluation then spawns the deformation
+	 * of their children, the other objects are cheap and updated by chunks. */
 	for (KX_GameObject *gameobj : m_animatedlist) {
-		if (!gameobj->IsActionsSuspended()) {
-			BLI_task_pool_push(m_animationPool, update_anim_thread_func, gameobj, false, TASK_PRIORITY_LOW);
+		if (gameobj->IsActionsSuspended()) {
+			continue;
+		}
+
+		if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+			BLI_task_pool_push(m_animationPool, update_armature_thread_func, gameobj, false, TASK_PRIORITY_LOW);
 		}
+		else {
+			m_animationObjects.push_back(gameobj);
+		}
+	}
+
+	const unsigned int numThreads = BLI_task_scheduler_num_threads(KX_GetActiveEngine()->GetTaskScheduler());
+	const unsigned int size = m_animationObjects.size();
+	const unsigned int chunkSize = std::max(16u, size / (numThreads * 4));
+	for (unsigned int i = 0; i < size; i += chunkSize) {
+		m_animationChunks.push_back({&m_animationObjects[i], std::min(chunkSize, size - i)});
+	}
+
+	for (AnimationChunk& chunk : m_animationChunks) {
+		BLI_task_pool_push(m_animationPool, update_anim_thread_func, &chunk, false, TASK_PRIORITY_LOW);
 	}
 
 	BLI_task_pool_work_and_wait(m_animationPool);
+
+	/* The updated deformers changed their bounding box after the bounds update of the frame,
+	 * outdate the bounds of their objects only so the next culling pass updates them. */
+	for (std::vector<KX_GameObject *>& objects : m_animationPoolData.deformedObjects) {
+		for (KX_GameObject *gameobj : objects) {
+			// Never a scene bounds frame.
+			gameobj->SetBoundsFrame(0);
+		}
+		objects.clear();
+	}
 }
 
 void KX_Scene::LogicUpdateFrame(double curtime)
 {
-	m_componentManager.UpdateComponents();
+	CM_ProfileScope profileScope("logic");
+	if (profileScope.IsActive()) {
+		profileScope.SetName(GetName(), "LogicUpdateFrame");
+	}
+
+	m_componentManager.UpdateComponents(m_logicmgr->GetCostProfile());
 
 	m_logicmgr->UpdateFrame(curtime);
+
+	// Adjust the velocity of the steering actuators using obstacle avoidance.
+	if (m_obstacleSimulation) {
+		m_obstacleSimulation->AdjustObstaclesVelocity();
+	}
+
+	ProceedPathQueries();
 }
 
 void KX_Scene::LogicEndFrame()
 {
+	CM_ProfileScope profileScope("logic");
+	if (profileScope.IsActive()) {
+		profileScope.SetName(GetName(), "LogicEndFrame");
+	}
+
 	m_logicmgr->EndFrame();
 
-	/* Don't remove the objects from the euthanasy list here as the child objects of a deleted
-	 * parent object are destructed directly from the sgnode in the same time the parent
-	 * object is destructed. These child objects must be removed automatically from the
-	 * euthanasy list to avoid double deletion in case the user ask to delete the child object
-	 * explicitly. NewRemoveObject is the place to do it.
+	/* The child objects of a deleted parent object are destructed directly from the sgnode
+	 * in the same time the parent object is destructed. These child objects are flagged
+	 * as pending removal and skipped to avoid double deletion in case the user ask to delete
+	 * the child object explicitly. The scene lists are compacted once at the end.
 	 */
 	while (!m_euthanasyobjects.empty()) {
-		RemoveObject(m_euthanasyobjects.front());
+		std::vector<KX_GameObject *> objects;
+		objects.swap(m_euthanasyobjects);
+
+		BeginObjectsRemoval();
+		for (KX_GameObject *gameobj : objects) {
+			// Replicas from an object pool are parked for the next AddReplicaObject.
+			if (!gameobj->IsPendingRemoval() && !ParkReplicaObject(gameobj)) {
+				RemoveObject(gameobj);
+			}
+		}
+		EndObjectsRemoval();
 	}
 
 	//prepare obstacle simulation for new frame
@@ -1389,13 +2020,96 @@ void KX_Scene::LogicEndFrame()
 	}
 }
 
+static void update_parents_thread_func(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	SG_QList *head = (SG_QList *)taskdata;
+	SG_Node *node;
+
+	/* All the scheduled nodes of a familly are in the same list, the children
+	 * updated with their parent are then removed from this list only. */
+	while ((node = static_cast<SG_Node *>(head->Remove()))) {
+		node->UpdateWorldDataThread();
+	}
+}
+
+void KX_Scene::UpdateParentsParallel()
+{
+	TaskScheduler *scheduler = KX_GetActiveEngine()->GetTaskScheduler();
+	const unsigned int numThreads = BLI_task_scheduler_num_threads(scheduler);
+
+	/* Updating a node can schedule other nodes (e.g ipo changing the transform
+	 * of an other object), proceed until no nodes are scheduled. */
+	while (!m_sghead.Empty()) {
+		m_sgnodes.clear();
+
+		SG_Node *scheduledNode;
+		while ((scheduledNode = SG_Node::GetNextScheduled(m_sghead))) {
+			m_sgnodes.push_back(scheduledNode);
+		}
+
+		// Group the nodes per familly and keep the scheduling order inside a familly, parents first.
+		std::stable_sort(m_sgnodes.begin(), m_sgnodes.end(), [](SG_Node *node1, SG_Node *node2) {
+			return node1->GetFamilly().get() < node2->GetFamilly().get();
+		});
+
+		// Number of nodes per task, never split a familly over two tasks.
+		const unsigned int taskSize = std::max(64u, (unsigned int)m_sgnodes.size() / (numThreads * 4));
+		const unsigned int maxTasks = m_sgnodes.size() / taskSize + 1;
+		// All the lists are empty here, it's safe to resize them.
+		if (m_sgtasks.size() < maxTasks) {
+			m_sgtasks.resize(maxTasks);
+		}
+
+		unsigned int task = 0;
+		unsigned int taskNodes = 0;
+		const SG_Familly *familly = nullptr;
+		for (SG_Node *node : m_sgnodes) {
+			const SG_Familly *nodeFamilly = node->GetFamilly().get();
+			if (nodeFamilly != familly) {
+				if (taskNodes >= taskSize) {
+					++task;
+					taskNodes = 0;
+				}
+				familly = nodeFamilly;
+			}
+
+			m_sgtasks[task].AddBack(node);
+			++taskNodes;
+		}
+
+		// Don't bother with the task pool for a single list.
+		if (task == 0) {
+			update_parents_thread_func(nullptr, &m_sgtasks[0], 0);
+			continue;
+		}
+
+		// The engine runs UpdateParents in its scene pool tasks, the node lists can't be pushed to that pool.
+		TaskPool *pool = BLI_task_pool_create(scheduler, nullptr);
+		for (unsigned int i = 0; i <= task; ++i) {
+			BLI_task_pool_push(pool, update_parents_thread_func, &m_sgtasks[i], false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
+	}
+}
+
 void KX_Scene::UpdateParents()
 {
+	CM_ProfileScope profileScope("scenegraph");
+	if (profileScope.IsActive()) {
+		profileScope.SetName(GetName(), "UpdateParents");
+	}
+
 	// We use the SG dynamic list
 	SG_Node *node;
 
-	while ((node = SG_Node::GetNextScheduled(m_sghead))) {
-		node->UpdateWorldData();
+	if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PARALLEL_SCENEGRAPH)) {
+		UpdateParentsParallel();
+	}
+	else {
+		while ((node = SG_Node::GetNextScheduled(m_sghead))) {
+			node->UpdateWorldData();
+		}
 	}
 
 	// The list must be empty here
@@ -1725,6 +2439,52 @@ KX_ObstacleSimulation *KX_Scene::GetObstacleSimulation()
 	return m_obstacleSimulation;
 }
 
+void KX_Scene::AddPathQueryNavMesh(KX_NavMeshObject *navmesh)
+{
+	CM_ListAddIfNotFound(m_pathQueryNavMeshes, navmesh);
+}
+
+void KX_Scene::ProceedPathQueries()
+{
+	if (m_pathQueryNavMeshes.empty()) {
+		return;
+	}
+
+	std::vector<KX_NavMeshObject::PathQueryPtr> finishedQueries;
+	for (KX_NavMeshObject *navmesh : m_pathQueryNavMeshes) {
+		navmesh->ProceedPathQueries(finishedQueries);
+	}
+
+	// Keep only the navigation meshes with queries left by the budget.
+	m_pathQueryNavMeshes.erase(std::remove_if(m_pathQueryNavMeshes.begin(), m_pathQueryNavMeshes.end(),
+			[](KX_NavMeshObject *navmesh) { return !navmesh->HasPathQueries(); }), m_pathQueryNavMeshes.end());
+
+#ifdef WITH_PYTHON
+	// The callbacks are called last as they could request new paths.
+	for (const KX_NavMeshObject::PathQueryPtr& query : finishedQueries) {
+		if (!query->m_callback) {
+			continue;
+		}
+
+		const unsigned int pathLen = query->m_path.size();
+		PyObject *pathList = PyList_New(pathLen);
+		for (unsigned int i = 0; i < pathLen; ++i) {
+			PyList_SET_ITEM(pathList, i, PyObjectFrom(query->m_path[i]));
+		}
+
+		PyObject *ret = PyObject_CallFunctionObjArgs(query->m_callback, pathList, nullptr);
+		if (ret) {
+			Py_DECREF(ret);
+		}
+		else {
+			PyErr_Print();
+			PyErr_Clear();
+		}
+		Py_DECREF(pathList);
+	}
+#endif  // WITH_PYTHON
+}
+
 void KX_Scene::SetObstacleSimulation(KX_ObstacleSimulation *obstacleSimulation)
 {
 	m_obstacleSimulation = obstacleSimulation;
@@ -1775,6 +2535,8 @@ PyTypeObject KX_Scene::Type = {
 
 PyMethodDef KX_Scene::Methods[] = {
 	EXP_PYMETHODTABLE(KX_Scene, addObject),
+	EXP_PYMETHODTABLE(KX_Scene, enableObjectPool),
+	EXP_PYMETHODTABLE(KX_Scene, disableObjectPool),
 	EXP_PYMETHODTABLE(KX_Scene, end),
 	EXP_PYMETHODTABLE(KX_Scene, restart),
 	EXP_PYMETHODTABLE(KX_Scene, replace),
@@ -2144,6 +2906,56 @@ EXP_PYMETHODDEF_DOC(KX_Scene, addObject,
 	return replica->GetProxy();
 }
 
+EXP_PYMETHODDEF_DOC(KX_Scene, enableObjectPool,
+                    "enableObjectPool(object, size=0)\n"
+                    "Reuses the removed replicas of the object in the next added objects.\n")
+{
+	PyObject *pyob;
+	KX_GameObject *ob;
+	unsigned int size = 0;
+
+	if (!PyArg_ParseTuple(args, "O|I:enableObjectPool", &pyob, &size)) {
+		return nullptr;
+	}
+
+	if (!ConvertPythonToGameObject(m_logicmgr, pyob, &ob, false, "scene.enableObjectPool(object, size): KX_Scene (first argument)")) {
+		return nullptr;
+	}
+
+	if (!m_inactivelist->SearchValue(ob)) {
+		PyErr_Format(PyExc_ValueError, "scene.enableObjectPool(object, size): KX_Scene (first argument): object must be in an inactive layer");
+		return nullptr;
+	}
+
+	if (!EnableObjectPool(ob, size)) {
+		PyErr_Format(PyExc_ValueError, "scene.enableObjectPool(object, size): KX_Scene (first argument): "
+		             "object must not be a light, camera, text or navigation mesh and must not have children or dupli group");
+		return nullptr;
+	}
+
+	Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene, disableObjectPool,
+                    "disableObjectPool(object)\n"
+                    "Frees the parked replicas of the object.\n")
+{
+	PyObject *pyob;
+	KX_GameObject *ob;
+
+	if (!PyArg_ParseTuple(args, "O:disableObjectPool", &pyob)) {
+		return nullptr;
+	}
+
+	if (!ConvertPythonToGameObject(m_logicmgr, pyob, &ob, false, "scene.disableObjectPool(object): KX_Scene (first argument)")) {
+		return nullptr;
+	}
+
+	DisableObjectPool(ob);
+
+	Py_RETURN_NONE;
+}
+
 EXP_PYMETHODDEF_DOC(KX_Scene, end,
                     "end()\n"
                     "Removes this scene from the game.\n")
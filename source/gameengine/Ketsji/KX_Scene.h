@@ -60,10 +60,12 @@ class SCA_TimeEventManager;
 class SCA_MouseManager;
 class SCA_IInputDevice;
 class SCA_JoystickManager;
+class SCA_LogicCost;
 class KX_NetworkMessageScene;
 class KX_NetworkMessageManager;
 class KX_2DFilterManager;
 class KX_ObstacleSimulation;
+class KX_NavMeshObject;
 class KX_WorldInfo;
 class KX_Camera;
 class KX_FontObject;
@@ -99,6 +101,35 @@ public:
 	struct AnimationPoolData
 	{
 		double curtime;
+		/// Objects with an updated deformer per task thread, their bounds are outdated after the update.
+		std::vector<std::vector<KX_GameObject *> > deformedObjects;
+	};
+
+	/// Non-armature animated objects updated by a single animation task.
+	struct AnimationChunk
+	{
+		KX_GameObject **objects;
+		unsigned int count;
+	};
+
+	/// Cost counters of a logic brick or a python component.
+	struct LogicCost
+	{
+		KX_GameObject *m_object;
+		/// The logic brick or python component.
+		EXP_Value *m_owner;
+		/// "sensor", "controller", "actuator" or "component".
+		const char *m_type;
+		const SCA_LogicCost *m_cost;
+	};
+
+	/// Frustum and layer of a culling pass computed with other passes, see CalculateVisibleMeshes.
+	struct CullingPass
+	{
+		SG_Frustum m_frustum;
+		int m_layer;
+		/// Objects inside the frustum.
+		std::vector<KX_GameObject *> m_objects;
 	};
 
 	static SG_Callbacks m_callbacks;
@@ -129,12 +160,17 @@ private:
 	/// Manager used to update all the mesh bounding box.
 	RAS_BoundingBoxManager *m_boundingBoxManager;
 
-	std::vector<KX_GameObject *> m_tempObjectList;
+	/// Lifespan end time and object, sorted in a min-heap on the end time.
+	typedef std::pair<double, KX_GameObject *> ObjectLifespan;
+	/// The objects added with a lifespan, only the ending objects are visited each logic frame.
+	std::vector<ObjectLifespan> m_lifespanHeap;
+	/// Logic time elapsed in the scene, used to date the end of the objects lifespan.
+	double m_lifespanTime;
 
 	/**
 	 * The list of objects which have been removed during the
 	 * course of one frame. They are actually destroyed in
-	 * LogicEndFrame() via a call to RemoveObject().
+	 * LogicEndFrame() via a call to RemoveObjects().
 	 */
 	std::vector<KX_GameObject *> m_euthanasyobjects;
 
@@ -159,6 +195,10 @@ private:
 	 * for updates after udpate is over (slow parent, bone parent).
 	 */
 	SG_QList m_sghead;
+	/// Scheduled nodes grouped per familly, used by the parallel scenegraph update.
+	std::vector<SG_Node *> m_sgnodes;
+	/// Lists of scheduled nodes updated by each scenegraph task.
+	std::vector<SG_QList> m_sgtasks;
 
 	/// Various SCA managers used by the scene
 	SCA_LogicManager *m_logicmgr;
@@ -210,6 +250,20 @@ private:
 	 */
 	std::set<KX_GameObject *> m_groupGameObjects;
 
+	/** Parked replicas of every object with a pool, reused by AddReplicaObject
+	 * instead of replicating the object and its logic again.
+	 */
+	std::map<KX_GameObject *, std::vector<KX_GameObject *> > m_objectPools;
+	/// The pooled object of every replica created from a pool, in use or parked.
+	std::map<KX_GameObject *, KX_GameObject *> m_pooledReplicas;
+
+	/// Depth of the nested objects removals, the scene lists are compacted at the end of the outermost.
+	unsigned int m_removalDepth;
+	/// Objects removed during the current removal, a reference is kept until the lists are compacted.
+	std::vector<KX_GameObject *> m_removedObjects;
+	/// Replicas parked during the current removal.
+	std::vector<KX_GameObject *> m_parkedObjects;
+
 	/// The execution priority of replicated object actuators.
 	int m_ueberExecutionPriority;
 
@@ -229,6 +283,12 @@ private:
 	/// Occlusion culling resolution.
 	int m_dbvtOcclusionRes;
 
+	/** Frame number of the last objects bounds update, objects with a different
+	 * bounds frame are updated in the culling. The objects with a deformer updated
+	 * by the animations after this update are reset to an outdated bounds frame.
+	 */
+	unsigned int m_boundsFrame;
+
 	/// The framing settings used by this scene
 	RAS_FrameSettings m_frameSettings;
 
@@ -246,15 +306,52 @@ private:
 	KX_2DFilterManager *m_filterManager;
 
 	KX_ObstacleSimulation *m_obstacleSimulation;
+	/// Navigation meshes with pending path queries.
+	std::vector<KX_NavMeshObject *> m_pathQueryNavMeshes;
 
 	AnimationPoolData m_animationPoolData;
 	TaskPool *m_animationPool;
+	/// Non-armature animated objects of the current animation update, split in chunks.
+	std::vector<KX_GameObject *> m_animationObjects;
+	std::vector<AnimationChunk> m_animationChunks;
 	double m_previousAnimTime;
 
 	/// LOD Hysteresis settings.
 	bool m_isActivedHysteresis;
 	int m_lodHysteresisValue;
 
+	/** SceneGraph transformation update dispatching the independent node
+	 * hierarchies on the engine task scheduler.
+	 */
+	void UpdateParentsParallel();
+
+	/// Update the deformer and the bounding box of an object for the current bounds frame.
+	void UpdateObjectBounds(KX_GameObject *gameobj);
+
+	/// Schedule the removal of an added object, lifespan of zero means 'this object lives forever'.
+	void SetObjectLifespan(KX_GameObject *gameobj, float lifespan);
+	/** Put back in the scene a parked replica of a pool.
+	 * The properties get their initial values and the initial state is restored, which registers
+	 * and initializes again the sensors of this state. The internal data of the controllers and
+	 * actuators (e.g action frame, motion integral, random generator) is not reset.
+	 */
+	KX_GameObject *ReuseReplicaObject(KX_GameObject *originalobj, KX_GameObject *referenceobj, float lifespan,
+	                                  std::vector<KX_GameObject *>& pool);
+	/** Remove from the scene a replica created from a pool and park it in this pool.
+	 * The logic is stopped (state 0, actuators deactivated and without events), the actuators and
+	 * objects referencing the replica are unlinked like for a deleted object, the actions, physics,
+	 * timers, obstacle and components are suspended. The bricks of the replica stay linked.
+	 * \return False if the object is not pooled or can't be parked anymore, it must be removed normally.
+	 */
+	bool ParkReplicaObject(KX_GameObject *gameobj);
+
+	/** Begin a removal of objects, the removed objects are only flagged and stay in the scene lists
+	 * until the end of the outermost removal.
+	 */
+	void BeginObjectsRemoval();
+	/// End a removal of objects, the outermost removal compacts every scene list once.
+	void EndObjectsRemoval();
+
 public:
 	KX_Scene(SCA_IInputDevice *inputDevice,
 	         const std::string& scenename,
@@ -286,17 +383,31 @@ public:
 
 	void RemoveNodeDestructObject(KX_GameObject *gameobj);
 	void RemoveObject(KX_GameObject *gameobj);
+	/// Remove objects and their children, the scene lists are compacted once for all the objects.
+	void RemoveObjects(const std::vector<KX_GameObject *>& objects);
 	void RemoveDupliGroup(KX_GameObject *gameobj);
 	void DelayedRemoveObject(KX_GameObject *gameobj);
-	bool NewRemoveObject(KX_GameObject *gameobj);
+	void NewRemoveObject(KX_GameObject *gameobj);
 
 	void AddAnimatedObject(KX_GameObject *gameobj);
 
+	/** Enable the pool of replicas of an inactive object, the removed replicas are parked with their
+	 * logic and physics suspended, and reused by the next AddReplicaObject of this object.
+	 * \param size The number of replicas to create and park immediately.
+	 * \return False if the object can't be pooled: lights, cameras, texts, navigation meshes and
+	 * objects with children or a dupli group are not supported.
+	 */
+	bool EnableObjectPool(KX_GameObject *gameobj, unsigned int size);
+	/// Disable the pool of replicas of an object and free the parked replicas.
+	void DisableObjectPool(KX_GameObject *gameobj);
+
 	/**
 	 * \section Logic stuff
 	 * Initiate an update of the logic system.
 	 */
 	void LogicBeginFrame(double curtime, double framestep);
+	/// Return the logic time elapsed in the scene, compared to the end of the objects lifespan.
+	double GetLifespanTime() const;
 	void LogicUpdateFrame(double curtime);
 	void UpdateAnimations(double curtime, bool restrict);
 
@@ -351,14 +462,29 @@ public:
 	void SetWorldInfo(KX_WorldInfo *wi);
 	KX_WorldInfo *GetWorldInfo() const;
 
+	/** Update the active bounding boxes and the deformers in parallel and the bounds
+	 * of all the objects, called once per frame before any culling.
+	 */
+	void UpdateObjectsBounds();
 	void CalculateVisibleMeshes(std::vector<KX_GameObject *>& objects, KX_Camera *cam, int layer);
 	void CalculateVisibleMeshes(std::vector<KX_GameObject *>& objects, const SG_Frustum& frustum, int layer);
+	/** Compute the objects inside the frustum of several passes, optionally in parallel.
+	 * The objects inside at least one pass are then marked not culled, the other
+	 * objects keep their culling state, except with DBVT culling which is not thread
+	 * safe and proceeds the passes one by one.
+	 */
+	void CalculateVisibleMeshes(std::vector<CullingPass>& passes, bool parallel);
 
 	/// \section Debug draw.
 	void DrawDebug(RAS_DebugDraw& debugDraw, const std::vector<KX_GameObject *>& objects,
 			KX_DebugOption showBoundingBox, KX_DebugOption showArmatures);
 	void RenderDebugProperties(RAS_DebugDraw& debugDraw, int xindent, int ysize, int& xcoord, int& ycoord, unsigned short propsMax);
 
+	/// Append the costs of the logic bricks and components of the active objects called at least once.
+	void GetLogicCosts(std::vector<LogicCost>& costs);
+	/// Reset the costs of all the logic bricks and components.
+	void ResetLogicCosts();
+
 	/// Replicate the logic bricks associated to this object.
 	void ReplicateLogic(KX_GameObject *newobj);
 
@@ -421,12 +547,19 @@ public:
 	KX_ObstacleSimulation *GetObstacleSimulation();
 	void SetObstacleSimulation(KX_ObstacleSimulation *obstacleSimulation);
 
+	/// Register a navigation mesh to resolve its path queries at the end of the logic update.
+	void AddPathQueryNavMesh(KX_NavMeshObject *navmesh);
+	/// Resolve the path queries of the navigation meshes and call the python callbacks.
+	void ProceedPathQueries();
+
 	virtual std::string GetName();
 	virtual void SetName(const std::string& name);
 
 #ifdef WITH_PYTHON
 
 	EXP_PYMETHOD_DOC(KX_Scene, addObject);
+	EXP_PYMETHOD_DOC(KX_Scene, enableObjectPool);
+	EXP_PYMETHOD_DOC(KX_Scene, disableObjectPool);
 	EXP_PYMETHOD_DOC(KX_Scene, end);
 	EXP_PYMETHOD_DOC(KX_Scene, restart);
 	EXP_PYMETHOD_DOC(KX_Scene, replace);
@@ -60,7 +60,8 @@ KX_SteeringActuator::KX_SteeringActuator(SCA_IObject *gameobj, int mode, KX_Game
 	m_pathUpdatePeriod(pathUpdatePeriod),
 	m_lockzvel(lockzvel),
 	m_wayPointIdx(-1),
-	m_steerVec(mt::zero3)
+	m_steerVec(mt::zero3),
+	m_steerDelta(0.0)
 {
 	m_navmesh = static_cast<KX_NavMeshObject *>(navmesh);
 	if (m_navmesh) {
@@ -108,6 +109,7 @@ void KX_SteeringActuator::ProcessReplica()
 	if (m_navmesh) {
 		m_navmesh->RegisterActuator(this);
 	}
+	m_pathQuery.reset();
 	SCA_IActuator::ProcessReplica();
 }
 
@@ -127,6 +129,7 @@ bool KX_SteeringActuator::UnlinkObject(SCA_IObject *clientobj)
 	}
 	else if (clientobj == m_navmesh) {
 		m_navmesh = nullptr;
+		m_pathQuery.reset();
 		return true;
 	}
 	return false;
@@ -150,6 +153,7 @@ void KX_SteeringActuator::Relink(std::map<SCA_IObject *, SCA_IObject *>& obj_map
 		}
 		m_navmesh = navobj;
 		m_navmesh->RegisterActuator(this);
+		m_pathQuery.reset();
 	}
 }
 
@@ -161,6 +165,7 @@ bool KX_SteeringActuator::Update(double curtime)
 	if (m_posevent && !m_isActive) {
 		delta = 0.0;
 		m_pathUpdateTime = -1.0;
+		m_pathQuery.reset();
 		m_updateTime = curtime;
 		m_isActive = true;
 	}
@@ -217,13 +222,24 @@ bool KX_SteeringActuator::Update(double curtime)
 
 				static const float WAYPOINT_RADIUS(0.25f);
 
-				if (m_pathUpdateTime < 0 || (m_pathUpdatePeriod >= 0 &&
-					curtime - m_pathUpdateTime > ((double)m_pathUpdatePeriod / 1000.0)))
-				{
+				if (m_pathQuery && m_pathQuery->m_done) {
+					m_path = std::move(m_pathQuery->m_path);
+					m_pathQuery.reset();
+					m_wayPointIdx = m_path.size() > 1 ? 1 : -1;
+				}
+
+				// The first path is found immediately, the updates are resolved by the navigation mesh on worker threads.
+				if (m_pathUpdateTime < 0) {
 					m_pathUpdateTime = curtime;
 					m_path = m_navmesh->FindPath(mypos, targpos, MAX_PATH_LENGTH);
 					m_wayPointIdx = m_path.size() > 1 ? 1 : -1;
 				}
+				else if (!m_pathQuery && m_pathUpdatePeriod >= 0 &&
+					curtime - m_pathUpdateTime > ((double)m_pathUpdatePeriod / 1000.0))
+				{
+					m_pathUpdateTime = curtime;
+					m_pathQuery = m_navmesh->RequestPath(mypos, targpos, MAX_PATH_LENGTH);
+				}
 
 				if (m_wayPointIdx > 0) {
 					mt::vec3 waypoint = m_path[m_wayPointIdx];
@@ -253,42 +269,25 @@ bool KX_SteeringActuator::Update(double curtime)
 	}
 
 	if (apply_steerforce) {
-		bool isdyna = obj->IsDynamic();
-		if (isdyna) {
+		if (obj->IsDynamic()) {
 			m_steerVec.z = 0.0f;
 		}
 		m_steerVec.SafeNormalize();
-		mt::vec3 newvel = m_velocity * m_steerVec;
+		const mt::vec3 newvel = m_velocity * m_steerVec;
+		m_steerDelta = delta;
 
 		// Adjust velocity to avoid obstacles.
 		if (m_simulation && m_obstacle) {
 			if (m_enableVisualization) {
 				KX_RasterizerDrawDebugLine(mypos, mypos + newvel, mt::vec4(1.0f, 0.0f, 0.0f, 1.0f));
 			}
-			m_simulation->AdjustObstacleVelocity(m_obstacle, m_mode != KX_STEERING_PATHFOLLOWING ? m_navmesh : nullptr,
-			                                     newvel, m_acceleration * (float)delta, m_turnspeed / (180.0f * (float)(M_PI * delta)));
-			if (m_enableVisualization) {
-				KX_RasterizerDrawDebugLine(mypos, mypos + newvel, mt::vec4(0.0f, 1.0f, 0.0f, 1.0f));
-			}
-		}
-
-		HandleActorFace(newvel);
-		if (isdyna) {
-			// Temporary solution: set 2D steering velocity directly to obj correct way is to apply physical force.
-			const mt::vec3 curvel = obj->GetLinearVelocity();
-
-			if (m_lockzvel) {
-				newvel.z = 0.0f;
-			}
-			else {
-				newvel.z = curvel.z;
-			}
-
-			obj->setLinearVelocity(newvel, false);
+			/* The velocity is adjusted with the one of all the other agents once
+			 * all the actuators are updated, ApplySteering is called after. */
+			m_simulation->RequestObstacleVelocity(this, m_obstacle, m_mode != KX_STEERING_PATHFOLLOWING ? m_navmesh : nullptr,
+			                                      newvel, m_acceleration * (float)delta, m_turnspeed / (180.0f * (float)(M_PI * delta)));
 		}
 		else {
-			const mt::vec3 movement = ((float)delta) * newvel;
-			obj->ApplyMovement(movement, false);
+			ApplySteering(newvel);
 		}
 	}
 	else {
@@ -305,6 +304,36 @@ bool KX_SteeringActuator::Update(double curtime)
 	return true;
 }
 
+void KX_SteeringActuator::ApplySteering(const mt::vec3& velocity)
+{
+	KX_GameObject *obj = static_cast<KX_GameObject *>(GetParent());
+	mt::vec3 newvel = velocity;
+
+	if (m_simulation && m_obstacle && m_enableVisualization) {
+		const mt::vec3& mypos = obj->NodeGetWorldPosition();
+		KX_RasterizerDrawDebugLine(mypos, mypos + newvel, mt::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+	}
+
+	HandleActorFace(newvel);
+	if (obj->IsDynamic()) {
+		// Temporary solution: set 2D steering velocity directly to obj correct way is to apply physical force.
+		const mt::vec3 curvel = obj->GetLinearVelocity();
+
+		if (m_lockzvel) {
+			newvel.z = 0.0f;
+		}
+		else {
+			newvel.z = curvel.z;
+		}
+
+		obj->setLinearVelocity(newvel, false);
+	}
+	else {
+		const mt::vec3 movement = ((float)m_steerDelta) * newvel;
+		obj->ApplyMovement(movement, false);
+	}
+}
+
 const mt::vec3& KX_SteeringActuator::GetSteeringVec() const
 {
 	if (m_isActive) {
@@ -605,6 +634,7 @@ int KX_SteeringActuator::pyattr_set_navmesh(EXP_PyObjectPlus *self, const struct
 	}
 
 	actuator->m_navmesh = static_cast<KX_NavMeshObject *>(gameobj);
+	actuator->m_pathQuery.reset();
 
 	if (actuator->m_navmesh) {
 		actuator->m_navmesh->RegisterActuator(actuator);
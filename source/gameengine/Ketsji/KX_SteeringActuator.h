@@ -62,10 +62,14 @@ class KX_SteeringActuator : public SCA_IActuator, public mt::SimdClassAllocator
 	KX_NavMeshObject::PathType m_path;
 	int m_pathUpdatePeriod;
 	double m_pathUpdateTime;
+	/// Pending path query of a periodic path update, the previous path is followed until it is resolved.
+	KX_NavMeshObject::PathQueryPtr m_pathQuery;
 	bool m_lockzvel;
 	int m_wayPointIdx;
 	mt::mat3 m_parentlocalmat;
 	mt::vec3 m_steerVec;
+	/// Time elapsed since the previous update, used to move non dynamic objects in ApplySteering.
+	double m_steerDelta;
 
 	void HandleActorFace(const mt::vec3& velocity);
 
@@ -92,6 +96,8 @@ public:
 	virtual void Relink(std::map<SCA_IObject *, SCA_IObject *>& obj_map);
 	virtual bool UnlinkObject(SCA_IObject *clientobj);
 	const mt::vec3& GetSteeringVec() const;
+	/// Move the object with the velocity computed in Update, eventually adjusted by the obstacle simulation.
+	void ApplySteering(const mt::vec3& velocity);
 
 #ifdef WITH_PYTHON
 
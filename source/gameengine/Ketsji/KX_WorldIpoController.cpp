@@ -32,7 +32,7 @@
 
 #include "KX_WorldIpoController.h"
 #include "KX_WorldInfo.h"
-#include "KX_Globals.h"
+#include "KX_GameObject.h"
 #include "KX_Scene.h"
 
 bool KX_WorldIpoController::Update()
@@ -41,7 +41,10 @@ bool KX_WorldIpoController::Update()
 		return false;
 	}
 
-	KX_WorldInfo *world = KX_GetActiveScene()->GetWorldInfo();
+	/* Use the scene of the animated object instead of the active scene as the
+	 * scene graph of multiple scenes can be updated in parallel. */
+	KX_GameObject *gameobj = static_cast<KX_GameObject *>(m_node->GetSGClientObject());
+	KX_WorldInfo *world = gameobj->GetScene()->GetWorldInfo();
 
 	if (m_modify_mist_start) {
 		world->setMistStart(m_mist_start);
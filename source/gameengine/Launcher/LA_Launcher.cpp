@@ -73,6 +73,8 @@ extern "C" {
 #  include "DNA_material_types.h"
 
 #  include "wm_event_types.h"
+
+#  include "PIL_time.h"
 }
 
 #ifdef WITH_AUDASPACE
@@ -88,6 +90,7 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system, Main *maggie, Scene *scene, Glob
 	m_exitRequested(KX_ExitRequest::NO_REQUEST),
 	m_globalSettings(gs),
 	m_system(system),
+	m_headless(system == nullptr),
 	m_ketsjiEngine(nullptr),
 	m_kxsystem(nullptr), 
 	m_inputDevice(nullptr),
@@ -100,6 +103,9 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system, Main *maggie, Scene *scene, Glob
 #endif  // WITH_PYTHON
 	m_samples(samples),
 	m_stereoMode(stereoMode),
+	m_unlimitedTicRate(false),
+	m_maxFrames(0),
+	m_frameCount(0),
 	m_argc(argc),
 	m_argv(argv)
 {
@@ -154,6 +160,16 @@ void LA_Launcher::InitEngine()
 	short showShadowFrustum = SYS_GetCommandLineInt(syshandle, "show_shadow_frustum", gm.showShadowFrustum);
 	bool nodepwarnings = (SYS_GetCommandLineInt(syshandle, "ignore_deprecation_warnings", 1) != 0);
 	bool restrictAnimFPS = (gm.flag & GAME_RESTRICT_ANIM_UPDATES) != 0;
+	bool parallelScenes = (SYS_GetCommandLineInt(syshandle, "parallel_scenes", 0) != 0);
+	bool parallelSceneGraph = (SYS_GetCommandLineInt(syshandle, "parallel_scenegraph", 0) != 0);
+	bool parallelPhysics = (SYS_GetCommandLineInt(syshandle, "parallel_physics", 0) != 0);
+	bool profileLogic = (SYS_GetCommandLineInt(syshandle, "profile_logic", 0) != 0);
+	bool parallelShadows = (SYS_GetCommandLineInt(syshandle, "parallel_shadows", 0) != 0);
+	bool cacheShadows = (SYS_GetCommandLineInt(syshandle, "cache_shadows", 0) != 0);
+	const float ticrate = SYS_GetCommandLineFloat(syshandle, "ticrate", gm.ticrate);
+	m_unlimitedTicRate = (SYS_GetCommandLineInt(syshandle, "unlimited_ticrate", 0) != 0);
+	const int maxFrames = SYS_GetCommandLineInt(syshandle, "max_frames", 0);
+	m_maxFrames = (maxFrames > 0) ? maxFrames : 0;
 
 	const KX_KetsjiEngine::FlagType flags = (KX_KetsjiEngine::FlagType)
 		((fixed_framerate ? KX_KetsjiEngine::FIXED_FRAMERATE : 0) |
@@ -161,7 +177,13 @@ void LA_Launcher::InitEngine()
 		(renderQueries ? KX_KetsjiEngine::SHOW_RENDER_QUERIES : 0) |
 		(restrictAnimFPS ? KX_KetsjiEngine::RESTRICT_ANIMATION : 0) |
 		(properties ? KX_KetsjiEngine::SHOW_DEBUG_PROPERTIES : 0) |
-		(profile ? KX_KetsjiEngine::SHOW_PROFILE : 0));
+		(profile ? KX_KetsjiEngine::SHOW_PROFILE : 0) |
+		(parallelScenes ? KX_KetsjiEngine::PARALLEL_SCENES : 0) |
+		(parallelSceneGraph ? KX_KetsjiEngine::PARALLEL_SCENEGRAPH : 0) |
+		(parallelPhysics ? KX_KetsjiEngine::PARALLEL_PHYSICS : 0) |
+		(profileLogic ? KX_KetsjiEngine::PROFILE_LOGIC : 0) |
+		(parallelShadows ? KX_KetsjiEngine::PARALLEL_SHADOWS : 0) |
+		(cacheShadows ? KX_KetsjiEngine::CACHE_SHADOWS : 0));
 
 	// Setup python console keys used as shortcut.
 	for (unsigned short i = 0; i < 4; ++i) {
@@ -171,7 +193,7 @@ void LA_Launcher::InitEngine()
 	}
 	m_pythonConsole.use = (gm.flag & GAME_PYTHON_CONSOLE);
 
-	m_rasterizer = new RAS_Rasterizer();
+	m_rasterizer = new RAS_Rasterizer(m_headless);
 
 	// Stereo parameters - Eye Separation from the UI - stereomode from the command-line/UI
 	m_rasterizer->SetStereoMode(m_stereoMode);
@@ -227,10 +249,12 @@ void LA_Launcher::InitEngine()
 		m_canvas->SetMouseState(RAS_ICanvas::MOUSE_INVISIBLE);
 	}
 
-	// Create the inputdevices.
+	// Create the inputdevices, they never receive events when running headless.
 	m_inputDevice = new DEV_InputDevice();
-	m_eventConsumer = new DEV_EventConsumer(m_system, m_inputDevice, m_canvas);
-	m_system->addEventConsumer(m_eventConsumer);
+	if (!m_headless) {
+		m_eventConsumer = new DEV_EventConsumer(m_system, m_inputDevice, m_canvas);
+		m_system->addEventConsumer(m_eventConsumer);
+	}
 
 	// Create a ketsjisystem (only needed for timing and stuff).
 	m_kxsystem = new LA_System();
@@ -263,7 +287,11 @@ void LA_Launcher::InitEngine()
 	m_ketsjiEngine->SetShowCameraFrustum((KX_DebugOption)showCameraFrustum);
 	m_ketsjiEngine->SetShowShadowFrustum((KX_DebugOption)showShadowFrustum);
 
-	m_ketsjiEngine->SetTicRate(gm.ticrate);
+	m_ketsjiEngine->SetTicRate(ticrate);
+	if (m_unlimitedTicRate) {
+		// The clock is advanced by the launcher of exactly one tic per frame.
+		m_ketsjiEngine->SetFlag(KX_KetsjiEngine::USE_EXTERNAL_CLOCK, true);
+	}
 	m_ketsjiEngine->SetMaxLogicFrame(gm.maxlogicstep);
 	m_ketsjiEngine->SetMaxPhysicsFrame(gm.maxphystep);
 	m_ketsjiEngine->SetTimeScale(gm.timeScale);
@@ -478,6 +506,10 @@ bool LA_Launcher::EngineNextFrame()
 	// Check if we can create a python console debugging.
 	HandlePythonConsole();
 #endif
+	if (m_unlimitedTicRate) {
+		m_ketsjiEngine->SetClockTime(m_ketsjiEngine->GetClockTime() + m_ketsjiEngine->GetTimeScale() / m_ketsjiEngine->GetTicRate());
+	}
+
 	// Kick the engine.
 	bool renderFrame = m_ketsjiEngine->NextFrame();
 
@@ -487,12 +519,27 @@ bool LA_Launcher::EngineNextFrame()
 
 	if (m_exitRequested == KX_ExitRequest::NO_REQUEST) {
 		if (renderFrame) {
-			RenderEngine();
+			if (m_headless) {
+				m_ketsjiEngine->UpdateWithoutRender();
+			}
+			else {
+				RenderEngine();
+			}
+
+			if (m_maxFrames > 0 && ++m_frameCount >= m_maxFrames) {
+				m_exitRequested = KX_ExitRequest::QUIT_GAME;
+			}
+		}
+		// Nothing to do until the next logic tic, without render there's no swap interval to wait for.
+		else if (m_headless && !m_unlimitedTicRate) {
+			PIL_sleep_ms(1);
 		}
 	}
 
-	m_system->processEvents(false);
-	m_system->dispatchEvents();
+	if (!m_headless) {
+		m_system->processEvents(false);
+		m_system->dispatchEvents();
+	}
 
 	if (m_inputDevice->GetInput((SCA_IInputDevice::SCA_EnumInputs)m_ketsjiEngine->GetExitKey()).Find(SCA_InputEvent::ACTIVE) &&
 		!m_inputDevice->GetHookExitKey())
@@ -61,8 +61,10 @@ protected:
 	std::string m_exitString;
 	GlobalSettings *m_globalSettings;
 
-	/// GHOST system abstraction.
+	/// GHOST system abstraction, nullptr when running headless.
 	GHOST_ISystem *m_system;
+	/// Run without window, events and GPU usage, the frames are never rendered.
+	bool m_headless;
 
 	/// The gameengine itself.
 	KX_KetsjiEngine* m_ketsjiEngine;
@@ -90,6 +92,12 @@ protected:
 	/// The render stereo mode passed in constructor.
 	RAS_Rasterizer::StereoMode m_stereoMode;
 
+	/// Advance the game time of one logic tic per frame without waiting the real time.
+	bool m_unlimitedTicRate;
+	/// Exit the game after this number of frames, ignored when zero.
+	unsigned int m_maxFrames;
+	unsigned int m_frameCount;
+
 	/// argc and argv need to be passed on to python
 	int m_argc;
 	char **m_argv;
@@ -43,6 +43,8 @@ extern "C" {
 
 #  include "BLI_fileops.h"
 
+#  include "DNA_scene_types.h"
+
 #  include "MEM_guardedalloc.h"
 }
 
@@ -126,6 +128,10 @@ void LA_PlayerLauncher::InitCamera()
 
 void LA_PlayerLauncher::SetWindowOrder(short order)
 {
+	if (!m_mainWindow) {
+		return;
+	}
+
 	m_mainWindow->setOrder((order == 0) ? GHOST_kWindowOrderBottom : GHOST_kWindowOrderTop);
 }
 
@@ -134,7 +140,9 @@ void LA_PlayerLauncher::InitEngine()
 	BKE_sound_init(m_maggie);
 	LA_Launcher::InitEngine();
 
-	m_rasterizer->PrintHardwareInfo();
+	if (!m_headless) {
+		m_rasterizer->PrintHardwareInfo();
+	}
 }
 
 void LA_PlayerLauncher::ExitEngine()
@@ -158,5 +166,14 @@ bool LA_PlayerLauncher::EngineNextFrame()
 
 RAS_ICanvas *LA_PlayerLauncher::CreateCanvas(RAS_Rasterizer *rasty)
 {
-	return (new GPG_Canvas(rasty, m_mainWindow));
+	GPG_Canvas *canvas = new GPG_Canvas(rasty, m_mainWindow);
+
+	// Without window use the player resolution of the game for the cameras projection.
+	if (!m_mainWindow) {
+		const GameData& gm = m_startScene->gm;
+		canvas->Resize(gm.xplay, gm.yplay);
+		canvas->SetViewPort(0, 0, gm.xplay, gm.yplay);
+	}
+
+	return canvas;
 }
@@ -721,6 +721,14 @@ void CcdPhysicsController::SimulationTick(float timestep)
  * SynchronizeMotionStates ynchronizes dynas, kinematic and deformable entities (and do 'late binding')
  */
 bool CcdPhysicsController::SynchronizeMotionStates(float time)
+{
+	SynchronizeWorldTransform();
+	SynchronizeScaling();
+
+	return true;
+}
+
+void CcdPhysicsController::SynchronizeWorldTransform()
 {
 	//sync non-static to motionstate, and static from motionstate (todo: add kinematic etc.)
 
@@ -741,7 +749,7 @@ bool CcdPhysicsController::SynchronizeMotionStates(float time)
 			m_MotionState->SetWorldPosition(ToMt(worldPos));
 		}
 		m_MotionState->CalculateWorldTransformations();
-		return true;
+		return;
 	}
 
 	btRigidBody *body = GetRigidBody();
@@ -754,11 +762,17 @@ bool CcdPhysicsController::SynchronizeMotionStates(float time)
 		m_MotionState->SetWorldPosition(ToMt(worldPos));
 		m_MotionState->CalculateWorldTransformations();
 	}
+}
+
+void CcdPhysicsController::SynchronizeScaling()
+{
+	// The soft body nodes are already in world space.
+	if (GetSoftBody()) {
+		return;
+	}
 
 	const mt::vec3& scale = m_MotionState->GetWorldScaling();
 	GetCollisionShape()->setLocalScaling(ToBullet(scale));
-
-	return true;
 }
 
 /**
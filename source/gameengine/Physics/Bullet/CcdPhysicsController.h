@@ -664,6 +664,12 @@ public:
 	 * SynchronizeMotionStates ynchronizes dynas, kinematic and deformable entities (and do 'late binding')
 	 */
 	virtual bool SynchronizeMotionStates(float time);
+	/// Synchronize the motion state transform with the dynamics, without touching the collision shape.
+	void SynchronizeWorldTransform();
+	/** Synchronize the collision shape scaling with the motion state, the shape
+	 * can be shared by other controllers.
+	 */
+	void SynchronizeScaling();
 
 	/**
 	 * Called for every physics simulation step. Use this method for
@@ -58,6 +58,7 @@
 
 extern "C" {
 	#include "BLI_utildefines.h"
+	#include "BLI_task.h"
 	#include "BKE_object.h"
 }
 
@@ -79,6 +80,7 @@ void DrawRasterizerLine(const float *from, const float *to, int color);
 #include "BulletDynamics/ConstraintSolver/btContactConstraint.h"
 
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 #include "CM_List.h"
 
 // This was copied from the old KX_ConvertPhysicsObjects
@@ -402,6 +404,9 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
 	m_linearDeactivationThreshold(0.8f),
 	m_angularDeactivationThreshold(1.0f),
 	m_contactBreakingThreshold(0.02f),
+	m_subStepBeginTime(0),
+	m_collisionBatchCallback(nullptr),
+	m_collisionBatchCallbackUserPtr(nullptr),
 	m_solver(nullptr),
 	m_filterCallback(nullptr),
 	m_ghostPairCallback(nullptr),
@@ -433,6 +438,7 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
 
 	m_dynamicsWorld = new btSoftRigidDynamicsWorld(dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
 	m_dynamicsWorld->setInternalTickCallback(&CcdPhysicsEnvironment::StaticSimulationSubtickCallback, this);
+	m_dynamicsWorld->setInternalTickCallback(&CcdPhysicsEnvironment::StaticSimulationPreSubtickCallback, this, true);
 
 	SetGravity(0.0f, 0.0f, -9.81f);
 }
@@ -440,9 +446,10 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
 void CcdPhysicsEnvironment::AddCcdPhysicsController(CcdPhysicsController *ctrl)
 {
 	// the controller is already added we do nothing
-	if (!m_controllers.insert(ctrl).second) {
+	if (!m_controllerIndices.emplace(ctrl, m_controllers.size()).second) {
 		return;
 	}
+	m_controllers.push_back(ctrl);
 
 	btRigidBody *body = ctrl->GetRigidBody();
 	btCollisionObject *obj = ctrl->GetCollisionObject();
@@ -576,10 +583,19 @@ void CcdPhysicsEnvironment::RestoreConstraint(CcdPhysicsController *ctrl, btType
 bool CcdPhysicsEnvironment::RemoveCcdPhysicsController(CcdPhysicsController *ctrl, bool freeConstraints)
 {
 	// if the physics controller is already removed we do nothing
-	if (!m_controllers.erase(ctrl)) {
+	std::unordered_map<CcdPhysicsController *, unsigned int>::iterator indexIt = m_controllerIndices.find(ctrl);
+	if (indexIt == m_controllerIndices.end()) {
 		return false;
 	}
 
+	// Move the last controller in place of the removed one.
+	const unsigned int index = indexIt->second;
+	CcdPhysicsController *lastCtrl = m_controllers.back();
+	m_controllers[index] = lastCtrl;
+	m_controllerIndices[lastCtrl] = index;
+	m_controllers.pop_back();
+	m_controllerIndices.erase(ctrl);
+
 	//also remove constraint
 	btRigidBody *body = ctrl->GetRigidBody();
 	if (body) {
@@ -661,7 +677,7 @@ void CcdPhysicsEnvironment::RefreshCcdPhysicsController(CcdPhysicsController *ct
 
 bool CcdPhysicsEnvironment::IsActiveCcdPhysicsController(CcdPhysicsController *ctrl)
 {
-	return (m_controllers.find(ctrl) != m_controllers.end());
+	return (m_controllerIndices.find(ctrl) != m_controllerIndices.end());
 }
 
 void CcdPhysicsEnvironment::AddCcdGraphicController(CcdGraphicController *ctrl)
@@ -721,25 +737,49 @@ void CcdPhysicsEnvironment::StaticSimulationSubtickCallback(btDynamicsWorld *wor
 
 void CcdPhysicsEnvironment::SimulationSubtickCallback(btScalar timeStep)
 {
-	std::set<CcdPhysicsController *>::iterator it;
+	for (CcdPhysicsController *ctrl : m_controllers) {
+		ctrl->SimulationTick(timeStep);
+	}
+
+	if (CM_Profiler::IsEnabled()) {
+		CM_Profiler::AddEvent("physics", "SubStep", m_subStepBeginTime, CM_Profiler::GetTime());
+	}
+}
+
+void CcdPhysicsEnvironment::StaticSimulationPreSubtickCallback(btDynamicsWorld *world, btScalar UNUSED(timeStep))
+{
+	CcdPhysicsEnvironment *this_ = static_cast<CcdPhysicsEnvironment *>(world->getWorldUserInfo());
+	this_->m_subStepBeginTime = CM_Profiler::GetTime();
+}
 
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		(*it)->SimulationTick(timeStep);
+void CcdPhysicsEnvironment::ApplySharedSettings()
+{
+	/* Update Bullet global variables only when they change, the environments proceeded
+	 * in parallel have the same values already applied and then only read them. */
+	if (gDeactivationTime != m_deactivationTime) {
+		gDeactivationTime = m_deactivationTime;
+	}
+	if (gContactBreakingThreshold != m_contactBreakingThreshold) {
+		gContactBreakingThreshold = m_contactBreakingThreshold;
 	}
 }
 
+bool CcdPhysicsEnvironment::HasSameSharedSettings(PHY_IPhysicsEnvironment *other) const
+{
+	const CcdPhysicsEnvironment *env = dynamic_cast<CcdPhysicsEnvironment *>(other);
+	return (!env || (env->m_deactivationTime == m_deactivationTime &&
+	                 env->m_contactBreakingThreshold == m_contactBreakingThreshold));
+}
+
 bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, float interval)
 {
-	std::set<CcdPhysicsController *>::iterator it;
+	CM_ProfileScope profileScope("physics", "ProceedDeltaTime");
+
 	int i;
 
-	// Update Bullet global variables.
-	gDeactivationTime = m_deactivationTime;
-	gContactBreakingThreshold = m_contactBreakingThreshold;
+	ApplySharedSettings();
 
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		(*it)->SynchronizeMotionStates(timeStep);
-	}
+	SynchronizeMotionStates(timeStep);
 
 	float subStep = timeStep / float(m_numTimeSubSteps);
 	i = m_dynamicsWorld->stepSimulation(interval, 25, subStep);//perform always a full simulation step
@@ -748,9 +788,7 @@ bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, flo
 
 	ProcessFhSprings(curTime, i * subStep);
 
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		(*it)->SynchronizeMotionStates(timeStep);
-	}
+	SynchronizeMotionStates(timeStep);
 
 	for (i = 0; i < m_wrapperVehicles.size(); i++) {
 		WrapperVehicle *veh = m_wrapperVehicles[i];
@@ -762,6 +800,61 @@ bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, flo
 	return true;
 }
 
+struct ControllerRange
+{
+	CcdPhysicsController **m_controllers;
+	unsigned int m_count;
+};
+
+static void synchronize_motion_states_thread_func(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	const ControllerRange *range = (ControllerRange *)taskdata;
+	for (unsigned int i = 0; i < range->m_count; ++i) {
+		range->m_controllers[i]->SynchronizeWorldTransform();
+	}
+}
+
+void CcdPhysicsEnvironment::SynchronizeMotionStates(float timeStep)
+{
+	KX_KetsjiEngine *engine = KX_GetActiveEngine();
+	const unsigned int count = m_controllers.size();
+
+	if (engine->GetFlag(KX_KetsjiEngine::PARALLEL_PHYSICS)) {
+		TaskScheduler *scheduler = engine->GetTaskScheduler();
+		const unsigned int numThreads = BLI_task_scheduler_num_threads(scheduler);
+		const unsigned int taskSize = std::max(64U, count / (numThreads * 4));
+
+		/* A controller only writes its own scene graph node, the node scheduling in the scene
+		 * update list is already protected. The collision shape can be shared between controllers
+		 * (e.g replicas), its scaling is then applied after. */
+		if (count > taskSize) {
+			std::vector<ControllerRange> ranges;
+			ranges.reserve(count / taskSize + 1);
+			for (unsigned int start = 0; start < count; start += taskSize) {
+				ranges.push_back({&m_controllers[start], std::min(taskSize, count - start)});
+			}
+
+			/* ProceedDeltaTime runs in a physics task of the engine scene pool which is being waited on,
+			 * the synchronization waits on its own nested pool. */
+			TaskPool *pool = BLI_task_pool_create(scheduler, nullptr);
+			for (ControllerRange& range : ranges) {
+				BLI_task_pool_push(pool, synchronize_motion_states_thread_func, &range, false, TASK_PRIORITY_HIGH);
+			}
+			BLI_task_pool_work_and_wait(pool);
+			BLI_task_pool_free(pool);
+
+			for (CcdPhysicsController *ctrl : m_controllers) {
+				ctrl->SynchronizeScaling();
+			}
+			return;
+		}
+	}
+
+	for (CcdPhysicsController *ctrl : m_controllers) {
+		ctrl->SynchronizeMotionStates(timeStep);
+	}
+}
+
 class ClosestRayResultCallbackNotMe : public btCollisionWorld::ClosestRayResultCallback
 {
 	btCollisionObject *m_owner;
@@ -790,12 +883,9 @@ public:
 
 void CcdPhysicsEnvironment::ProcessFhSprings(double curTime, float interval)
 {
-	std::set<CcdPhysicsController *>::iterator it;
-
 	const float step = interval * KX_GetActiveEngine()->GetTicRate();
 
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		CcdPhysicsController *ctrl = (*it);
+	for (CcdPhysicsController *ctrl : m_controllers) {
 		btRigidBody *body = ctrl->GetRigidBody();
 
 		if (body && (ctrl->GetConstructionInfo().m_do_fh || ctrl->GetConstructionInfo().m_do_rot_fh)) {
@@ -947,9 +1037,10 @@ void CcdPhysicsEnvironment::SetDeactivationAngularTreshold(float angTresh)
 	m_angularDeactivationThreshold = angTresh;
 
 	// Update from all controllers.
-	for (std::set<CcdPhysicsController *>::iterator it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		if ((*it)->GetRigidBody())
-			(*it)->GetRigidBody()->setSleepingThresholds(m_linearDeactivationThreshold, m_angularDeactivationThreshold);
+	for (CcdPhysicsController *ctrl : m_controllers) {
+		if (ctrl->GetRigidBody()) {
+			ctrl->GetRigidBody()->setSleepingThresholds(m_linearDeactivationThreshold, m_angularDeactivationThreshold);
+		}
 	}
 }
 
@@ -1937,11 +2028,8 @@ void CcdPhysicsEnvironment::MergeEnvironment(PHY_IPhysicsEnvironment *other_env)
 		return;
 	}
 
-	std::set<CcdPhysicsController *>::iterator it;
-
-	while (other->m_controllers.begin() != other->m_controllers.end()) {
-		it = other->m_controllers.begin();
-		CcdPhysicsController *ctrl = (*it);
+	while (!other->m_controllers.empty()) {
+		CcdPhysicsController *ctrl = other->m_controllers.back();
 
 		other->RemoveCcdPhysicsController(ctrl, true);
 		this->AddCcdPhysicsController(ctrl);
@@ -2026,6 +2114,12 @@ void CcdPhysicsEnvironment::AddCollisionCallback(int response_class, PHY_Respons
 	m_triggerCallbacks[response_class] = callback;
 	m_triggerCallbacksUserPtrs[response_class] = user;
 }
+
+void CcdPhysicsEnvironment::AddCollisionBatchCallback(PHY_CollisionBatchCallback callback, void *user)
+{
+	m_collisionBatchCallback = callback;
+	m_collisionBatchCallbackUserPtr = user;
+}
 bool CcdPhysicsEnvironment::RequestCollisionCallback(PHY_IPhysicsController *ctrl)
 {
 	CcdPhysicsController *ccdCtrl = static_cast<CcdPhysicsController *>(ctrl);
@@ -2034,10 +2128,14 @@ bool CcdPhysicsEnvironment::RequestCollisionCallback(PHY_IPhysicsController *ctr
 
 void CcdPhysicsEnvironment::CallbackTriggers()
 {
-	if (!m_triggerCallbacks[PHY_OBJECT_RESPONSE]) {
+	if (!m_triggerCallbacks[PHY_OBJECT_RESPONSE] && !m_collisionBatchCallback) {
 		return;
 	}
 
+	// The collision data of the previous step are not used anymore.
+	m_collDatas.clear();
+	m_collisionPairs.clear();
+
 	// Walk over all overlapping pairs, and if one of the involved bodies is registered for trigger callback, perform callback.
 	btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
 	for (unsigned int i = 0, numManifolds = dispatcher->getNumManifolds(); i < numManifolds; i++) {
@@ -2065,8 +2163,27 @@ void CcdPhysicsEnvironment::CallbackTriggers()
 			continue;
 		}
 
-		const CcdCollData *coll_data = new CcdCollData(manifold);
-		m_triggerCallbacks[PHY_OBJECT_RESPONSE](m_triggerCallbacksUserPtrs[PHY_OBJECT_RESPONSE], ctrl0, ctrl1, coll_data, first);
+		m_collDatas.emplace_back(manifold);
+		m_collisionPairs.push_back({ctrl0, ctrl1, nullptr, first});
+	}
+
+	if (m_collisionPairs.empty()) {
+		return;
+	}
+
+	// Link the collision data once all added as the storage can move while growing.
+	for (unsigned int i = 0, size = m_collisionPairs.size(); i < size; ++i) {
+		m_collisionPairs[i].collData = &m_collDatas[i];
+	}
+
+	if (m_collisionBatchCallback) {
+		m_collisionBatchCallback(m_collisionBatchCallbackUserPtr, m_collisionPairs.data(), m_collisionPairs.size());
+	}
+	else {
+		for (const PHY_CollisionPair& pair : m_collisionPairs) {
+			m_triggerCallbacks[PHY_OBJECT_RESPONSE](m_triggerCallbacksUserPtrs[PHY_OBJECT_RESPONSE],
+			                                        pair.ctrl1, pair.ctrl2, pair.collData, pair.first);
+		}
 	}
 }
 
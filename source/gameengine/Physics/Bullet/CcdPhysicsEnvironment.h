@@ -30,6 +30,7 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <unordered_map>
 class CcdGraphicController;
 #include "LinearMath/btVector3.h"
 #include "LinearMath/btTransform.h"
@@ -55,6 +56,24 @@ class CcdShapeConstructionInfo;
 /// Find the id of the closest node to a point in a soft body.
 int Ccd_FindClosestNode(btSoftBody *sb, const btVector3& worldPoint);
 
+class CcdCollData : public PHY_ICollData
+{
+	const btPersistentManifold *m_manifoldPoint;
+public:
+	CcdCollData(const btPersistentManifold *manifoldPoint);
+	virtual ~CcdCollData();
+
+	virtual unsigned int GetNumContacts() const;
+	virtual mt::vec3 GetLocalPointA(unsigned int index, bool first) const;
+	virtual mt::vec3 GetLocalPointB(unsigned int index, bool first) const;
+	virtual mt::vec3 GetWorldPoint(unsigned int index, bool first) const;
+	virtual mt::vec3 GetNormal(unsigned int index, bool first) const;
+	virtual float GetCombinedFriction(unsigned int index, bool first) const;
+	virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
+	virtual float GetCombinedRestitution(unsigned int index, bool first) const;
+	virtual float GetAppliedImpulse(unsigned int index, bool first) const;
+};
+
 /** CcdPhysicsEnvironment is an experimental mainloop for physics simulation using optional continuous collision detection.
  * Physics Environment takes care of stepping the simulation and is a container for physics entities.
  * It stores rigidbodies,constraints, materials etc.
@@ -99,7 +118,16 @@ protected:
 	float m_angularDeactivationThreshold;
 	float m_contactBreakingThreshold;
 
+	/// Begin time of the current simulation sub step for the profiler.
+	int64_t m_subStepBeginTime;
+
 	void ProcessFhSprings(double curTime, float timeStep);
+	/** Synchronize the motion states of all the controllers, the controllers
+	 * are split in ranges proceeded on the engine task scheduler when
+	 * PARALLEL_PHYSICS is enabled. The collision shapes scaling is always
+	 * synchronized serially.
+	 */
+	void SynchronizeMotionStates(float timeStep);
 
 public:
 	CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling);
@@ -137,6 +165,9 @@ public:
 	}
 	/// Perform an integration step of duration 'timeStep'.
 	virtual bool ProceedDeltaTime(double curTime, float timeStep, float interval);
+	/// Set the Bullet global deactivation time and contact breaking threshold.
+	virtual void ApplySharedSettings();
+	virtual bool HasSameSharedSettings(PHY_IPhysicsEnvironment *other) const;
 
 	/**
 	 * Called by Bullet for every physical simulation (sub)tick.
@@ -145,6 +176,8 @@ public:
 	 */
 	static void StaticSimulationSubtickCallback(btDynamicsWorld *world, btScalar timeStep);
 	void SimulationSubtickCallback(btScalar timeStep);
+	/// Called by Bullet before every simulation sub tick.
+	static void StaticSimulationPreSubtickCallback(btDynamicsWorld *world, btScalar timeStep);
 
 	virtual void DebugDrawWorld();
 //		virtual bool		proceedDeltaTimeOneStep(float timeStep);
@@ -195,6 +228,7 @@ public:
 	virtual void AddSensor(PHY_IPhysicsController *ctrl);
 	virtual void RemoveSensor(PHY_IPhysicsController *ctrl);
 	virtual void AddCollisionCallback(int response_class, PHY_ResponseCallback callback, void *user);
+	virtual void AddCollisionBatchCallback(PHY_CollisionBatchCallback callback, void *user);
 	virtual bool RequestCollisionCallback(PHY_IPhysicsController *ctrl);
 	virtual bool RemoveCollisionCallback(PHY_IPhysicsController *ctrl);
 	virtual PHY_CollisionTestResult CheckCollision(PHY_IPhysicsController *ctrl0, PHY_IPhysicsController *ctrl1);
@@ -269,11 +303,22 @@ public:
 	                                    bRigidBodyJointConstraint *dat);
 
 protected:
-	std::set<CcdPhysicsController *> m_controllers;
+	/// All the active controllers, stored contiguously as they are iterated at each physics step.
+	std::vector<CcdPhysicsController *> m_controllers;
+	/// Index of each controller in m_controllers for constant time lookup and removal.
+	std::unordered_map<CcdPhysicsController *, unsigned int> m_controllerIndices;
 
 	PHY_ResponseCallback m_triggerCallbacks[PHY_NUM_RESPONSE];
 	void *m_triggerCallbacksUserPtrs[PHY_NUM_RESPONSE];
 
+	PHY_CollisionBatchCallback m_collisionBatchCallback;
+	void *m_collisionBatchCallbackUserPtr;
+
+	/// Collision data of the last step, the storage is reused at each step to avoid allocations.
+	std::vector<CcdCollData> m_collDatas;
+	/// Contact pairs of the last step referencing m_collDatas.
+	std::vector<PHY_CollisionPair> m_collisionPairs;
+
 	std::vector<WrapperVehicle *>    m_wrapperVehicles;
 
 	/** use explicit btSoftRigidDynamicsWorld/btDiscreteDynamicsWorld* so that we have access to
@@ -296,22 +341,4 @@ protected:
 	virtual void ExportFile(const std::string& filename);
 };
 
-class CcdCollData : public PHY_ICollData
-{
-	const btPersistentManifold *m_manifoldPoint;
-public:
-	CcdCollData(const btPersistentManifold *manifoldPoint);
-	virtual ~CcdCollData();
-
-	virtual unsigned int GetNumContacts() const;
-	virtual mt::vec3 GetLocalPointA(unsigned int index, bool first) const;
-	virtual mt::vec3 GetLocalPointB(unsigned int index, bool first) const;
-	virtual mt::vec3 GetWorldPoint(unsigned int index, bool first) const;
-	virtual mt::vec3 GetNormal(unsigned int index, bool first) const;
-	virtual float GetCombinedFriction(unsigned int index, bool first) const;
-	virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
-	virtual float GetCombinedRestitution(unsigned int index, bool first) const;
-	virtual float GetAppliedImpulse(unsigned int index, bool first) const;
-};
-
 #endif  /* __CCDPHYSICSENVIRONMENT_H__ */
@@ -66,8 +66,21 @@ struct PHY_CollisionTestResult
 	PHY_ICollData *collData;
 };
 
+/// A contact pair reported by the physics environment after a physics step.
+struct PHY_CollisionPair
+{
+	PHY_IPhysicsController *ctrl1;
+	PHY_IPhysicsController *ctrl2;
+	const PHY_ICollData *collData;
+	bool first;
+};
+
 using PHY_ResponseCallback = bool (*)(void *client_data, PHY_IPhysicsController *ctrl1, PHY_IPhysicsController *ctrl2,
 		const PHY_ICollData *coll_data, bool first);
+/** Receive all the contact pairs of a physics step at once, the pairs and their
+ * collision data are owned by the physics environment until its next step.
+ */
+using PHY_CollisionBatchCallback = void (*)(void *client_data, const PHY_CollisionPair *pairs, unsigned int count);
 using PHY_CullingCallback =  void (*)(KX_ClientObjectInfo *info, void *param);
 
 /// PHY_ConstraintType enumerates all supported Constraint Types
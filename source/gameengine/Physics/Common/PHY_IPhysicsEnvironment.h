@@ -118,6 +118,19 @@ public:
 	}
 	/// Perform an integration step of duration 'timeStep'.
 	virtual bool ProceedDeltaTime(double curTime, float timeStep, float interval) = 0;
+	/** Apply the settings shared by all the environments of the process, e.g global variables
+	 * of the physics library. Called by ProceedDeltaTime.
+	 */
+	virtual void ApplySharedSettings()
+	{
+	}
+	/** Return true when the shared settings of both environments are the same, only these
+	 * environments can proceed at the same time once one applied its shared settings.
+	 */
+	virtual bool HasSameSharedSettings(PHY_IPhysicsEnvironment *other) const
+	{
+		return true;
+	}
 	/// draw debug lines (make sure to call this during the render phase, otherwise lines are not drawn properly)
 	virtual void DebugDrawWorld()
 	{
@@ -221,6 +234,8 @@ public:
 	virtual void AddSensor(PHY_IPhysicsController *ctrl) = 0;
 	virtual void RemoveSensor(PHY_IPhysicsController *ctrl) = 0;
 	virtual void AddCollisionCallback(int response_class, PHY_ResponseCallback callback, void *user) = 0;
+	/// Set the callback receiving all the object contact pairs of a step, used instead of PHY_OBJECT_RESPONSE.
+	virtual void AddCollisionBatchCallback(PHY_CollisionBatchCallback callback, void *user) = 0;
 	virtual bool RequestCollisionCallback(PHY_IPhysicsController *ctrl) = 0;
 	virtual bool RemoveCollisionCallback(PHY_IPhysicsController *ctrl) = 0;
 	virtual PHY_CollisionTestResult CheckCollision(PHY_IPhysicsController *ctrl0, PHY_IPhysicsController *ctrl1) = 0;
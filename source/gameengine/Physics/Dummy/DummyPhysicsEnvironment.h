@@ -96,6 +96,9 @@ public:
 	virtual void AddCollisionCallback(int response_class, PHY_ResponseCallback callback, void *user)
 	{
 	}
+	virtual void AddCollisionBatchCallback(PHY_CollisionBatchCallback callback, void *user)
+	{
+	}
 	virtual bool RequestCollisionCallback(PHY_IPhysicsController *ctrl)
 	{
 		return false;
@@ -112,8 +112,7 @@ public:
 
 		this->Unbind(tuple);
 
-		// In the same time we can remove the children nodes.
-		Clear();
+		// The children are kept, the owner of the node clears them when it generates a different tree.
 	}
 
 	/// Function override to avoid try creating a RAS_DummyNodeTuple with arguments.
@@ -124,8 +123,6 @@ public:
 		this->Bind(tuple);
 
 		this->Unbind(tuple);
-
-		// No need to clear as dummy node are never instanced.
 	}
 
 #ifdef DEBUG
@@ -68,6 +68,11 @@ void RAS_BoundingBoxManager::ClearModified()
 	}
 }
 
+const RAS_BoundingBoxList& RAS_BoundingBoxManager::GetActiveBoundingBoxList() const
+{
+	return m_activeBoundingBoxList;
+}
+
 void RAS_BoundingBoxManager::Merge(RAS_BoundingBoxManager *other)
 {
 	for (RAS_BoundingBox *boundingBox : other->m_boundingBoxList) {
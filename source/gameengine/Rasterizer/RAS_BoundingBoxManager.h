@@ -63,6 +63,9 @@ public:
 	/// Set all the active bounding box unmodified.
 	void ClearModified();
 
+	/// Return the bounding boxes used by at least one mesh user.
+	const RAS_BoundingBoxList& GetActiveBoundingBoxList() const;
+
 	/** Merge an other bounding box manager.
 	 * \param other The bounding box manager to merge data from. This manager is empty after the merge.
 	 */
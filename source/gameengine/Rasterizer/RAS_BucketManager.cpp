@@ -76,6 +76,32 @@ bool RAS_BucketManager::fronttoback::operator()(const SortedMeshSlot &a, const S
 	return (a.m_z > b.m_z) || (a.m_z == b.m_z && a.m_ms > b.m_ms);
 }
 
+/** Sort the slots with an insertion sort, efficient when the slots are in the order
+ * of a previous frame and almost sorted.
+ * \param maxMoves The maximum number of slot moves before giving up.
+ * \return False if the slots are not sorted because of too many moves.
+ */
+static bool insertion_sort_slots(std::vector<RAS_BucketManager::SortedMeshSlot>& slots, unsigned int maxMoves)
+{
+	RAS_BucketManager::backtofront compare;
+	unsigned int moves = 0;
+
+	for (unsigned int i = 1, size = slots.size(); i < size; ++i) {
+		const RAS_BucketManager::SortedMeshSlot slot = slots[i];
+		unsigned int j = i;
+		for (; j > 0 && compare(slot, slots[j - 1]); --j) {
+			slots[j] = slots[j - 1];
+			if (++moves > maxMoves) {
+				slots[j - 1] = slot;
+				return false;
+			}
+		}
+		slots[j] = slot;
+	}
+
+	return true;
+}
+
 RAS_BucketManager::RAS_BucketManager(RAS_IPolyMaterial *textMaterial)
 	:m_downwardNode(this, &m_nodeData, nullptr, nullptr),
 	m_upwardNode(this, &m_nodeData, nullptr, nullptr)
@@ -99,27 +125,49 @@ RAS_BucketManager::~RAS_BucketManager()
 void RAS_BucketManager::RenderSortedBuckets(RAS_Rasterizer *rasty, RAS_BucketManager::BucketType bucketType)
 {
 	BucketList& solidBuckets = m_buckets[bucketType];
-	RAS_UpwardTreeLeafs leafs;
+	m_sortLeafs.clear();
+	const unsigned int pass = GetPassIndex(bucketType);
 	for (RAS_MaterialBucket *bucket : solidBuckets) {
-		bucket->GenerateTree(m_downwardNode, m_upwardNode, leafs, m_nodeData.m_drawingMode, true);
+		bucket->GenerateTree(m_downwardNode, m_upwardNode, m_sortLeafs, m_nodeData.m_drawingMode, true, pass);
 	}
 
 	m_nodeData.m_sort = true;
 
 	if (m_downwardNode.GetValid()) {
 		m_downwardNode.Execute(RAS_DummyNodeTuple());
+		m_downwardNode.Clear();
 	}
-	if (!leafs.empty()) {
+	if (!m_sortLeafs.empty()) {
 		/* Camera's near plane equation: pnorm.dot(point) + pval,
 		 * but we leave out pval since it's constant anyway */
 		const mt::mat3x4& trans = m_nodeData.m_trans;
 		const mt::vec3 pnorm(trans[2], trans[5], trans[8]);
-		std::vector<SortedMeshSlot> sortedSlots(leafs.size());
-		// Generate all SortedMeshSlot corresponding to all the leafs nodes.
-		std::transform(leafs.begin(), leafs.end(), sortedSlots.begin(),
-				[&pnorm](RAS_MeshSlotUpwardNode *node) { return SortedMeshSlot(node, pnorm); });
 
-		std::sort(sortedSlots.begin(), sortedSlots.end(), backtofront());
+		SortCache& cache = m_sortCaches[bucketType][m_nodeData.m_drawingMode];
+		std::vector<SortedMeshSlot>& sortedSlots = cache.m_slots;
+
+		/* With the same leafs as the previous sort, the previous order contains only valid nodes
+		 * and is likely almost sorted, update the depths in this order and insertion sort them.
+		 * Otherwise generate all SortedMeshSlot corresponding to all the leafs nodes. */
+		if (m_sortLeafs == cache.m_leafs) {
+			for (SortedMeshSlot& slot : sortedSlots) {
+				slot = SortedMeshSlot(slot.m_node, pnorm);
+			}
+
+			if (!insertion_sort_slots(sortedSlots, sortedSlots.size() * 4)) {
+				std::sort(sortedSlots.begin(), sortedSlots.end(), backtofront());
+			}
+		}
+		else {
+			sortedSlots.resize(m_sortLeafs.size());
+			std::transform(m_sortLeafs.begin(), m_sortLeafs.end(), sortedSlots.begin(),
+					[&pnorm](RAS_MeshSlotUpwardNode *node) { return SortedMeshSlot(node, pnorm); });
+
+			std::sort(sortedSlots.begin(), sortedSlots.end(), backtofront());
+
+			// Keep the leafs for the next sort, the storages are swapped to avoid allocations.
+			std::swap(cache.m_leafs, m_sortLeafs);
+		}
 
 		std::vector<SortedMeshSlot>::const_iterator it = sortedSlots.begin();
 		RAS_MeshSlotUpwardNodeIterator iterator((it++)->m_node);
@@ -132,16 +180,24 @@ void RAS_BucketManager::RenderSortedBuckets(RAS_Rasterizer *rasty, RAS_BucketMan
 void RAS_BucketManager::RenderBasicBuckets(RAS_Rasterizer *rasty, RAS_BucketManager::BucketType bucketType)
 {
 	RAS_UpwardTreeLeafs leafs;
+	const unsigned int pass = GetPassIndex(bucketType);
 	for (RAS_MaterialBucket *bucket : m_buckets[bucketType]) {
-		bucket->GenerateTree(m_downwardNode, m_upwardNode, leafs, m_nodeData.m_drawingMode, false);
+		bucket->GenerateTree(m_downwardNode, m_upwardNode, leafs, m_nodeData.m_drawingMode, false, pass);
 	}
 
 	if (m_downwardNode.GetValid()) {
 		m_nodeData.m_sort = false;
 		m_downwardNode.Execute(RAS_DummyNodeTuple());
+		// Only the material trees are retained, the list of materials is generated for each render.
+		m_downwardNode.Clear();
 	}
 }
 
+unsigned int RAS_BucketManager::GetPassIndex(RAS_BucketManager::BucketType bucketType) const
+{
+	return (bucketType * RAS_Rasterizer::RAS_DRAW_MAX + m_nodeData.m_drawingMode);
+}
+
 void RAS_BucketManager::Renderbuckets(RAS_Rasterizer::DrawType drawingMode, const mt::mat3x4& cameratrans, RAS_Rasterizer *rasty,
 		RAS_OffScreen *offScreen)
 {
@@ -86,6 +86,19 @@ protected:
 
 	BucketList m_buckets[NUM_BUCKET_TYPE];
 
+	/// Depth sorted mesh slots kept between the frames to reuse the previous order and storage.
+	struct SortCache
+	{
+		/// Leafs used to generate the sorted mesh slots.
+		RAS_UpwardTreeLeafs m_leafs;
+		std::vector<SortedMeshSlot> m_slots;
+	};
+
+	/// Sort caches per bucket type and drawing mode.
+	SortCache m_sortCaches[NUM_BUCKET_TYPE][RAS_Rasterizer::RAS_DRAW_MAX];
+	/// Leafs generated for the current sorted render.
+	RAS_UpwardTreeLeafs m_sortLeafs;
+
 	RAS_ManagerNodeData m_nodeData;
 	RAS_ManagerDownwardNode m_downwardNode;
 	RAS_ManagerUpwardNode m_upwardNode;
@@ -121,6 +134,8 @@ public:
 private:
 	void RenderBasicBuckets(RAS_Rasterizer *rasty, BucketType bucketType);
 	void RenderSortedBuckets(RAS_Rasterizer *rasty, BucketType bucketType);
+	/// Index of the render of a bucket type with the current drawing mode, used to retain the render trees.
+	unsigned int GetPassIndex(BucketType bucketType) const;
 };
 
 #endif // __RAS_BUCKETMANAGER_H__
@@ -120,6 +120,11 @@ RAS_MeshMaterial *RAS_DisplayArrayBucket::GetMeshMaterial() const
 
 void RAS_DisplayArrayBucket::ActivateMesh(RAS_MeshSlot *slot)
 {
+	// Register to the material bucket only once per render.
+	if (m_activeMeshSlots.empty()) {
+		m_bucket->ActivateDisplayArrayBucket(this);
+	}
+
 	m_activeMeshSlots.push_back(slot);
 }
 
@@ -171,21 +176,17 @@ void RAS_DisplayArrayBucket::UpdateActiveMeshSlots(RAS_Rasterizer::DrawType draw
 	}
 }
 
-void RAS_DisplayArrayBucket::GenerateTree(RAS_MaterialDownwardNode& downwardRoot, RAS_MaterialUpwardNode& upwardRoot,
+RAS_DisplayArrayDownwardNode *RAS_DisplayArrayBucket::GenerateTree(RAS_MaterialUpwardNode& upwardRoot,
 		RAS_UpwardTreeLeafs& upwardLeafs, RAS_Rasterizer::DrawType drawingMode, bool sort, bool instancing)
 {
-	if (m_activeMeshSlots.empty()) {
-		return;
-	}
-
 	// Update deformer and render settings.
 	UpdateActiveMeshSlots(drawingMode);
 
 	if (instancing) {
-		downwardRoot.AddChild(&m_instancingNode);
+		return &m_instancingNode;
 	}
 	else if (UseBatching()) {
-		downwardRoot.AddChild(&m_batchingNode);
+		return &m_batchingNode;
 	}
 	else if (sort) {
 		for (RAS_MeshSlot *slot : m_activeMeshSlots) {
@@ -193,10 +194,10 @@ void RAS_DisplayArrayBucket::GenerateTree(RAS_MaterialDownwardNode& downwardRoot
 		}
 
 		m_upwardNode.SetParent(&upwardRoot);
+		return nullptr;
 	}
-	else {
-		downwardRoot.AddChild(&m_downwardNode);
-	}
+
+	return &m_downwardNode;
 }
 
 void RAS_DisplayArrayBucket::BindUpwardNode(const RAS_DisplayArrayNodeTuple& tuple)
@@ -102,8 +102,11 @@ public:
 	/// Update render infos.
 	void UpdateActiveMeshSlots(RAS_Rasterizer::DrawType drawingMode);
 
-	void GenerateTree(RAS_MaterialDownwardNode& downwardRoot, RAS_MaterialUpwardNode& upwardRoot,
-			RAS_UpwardTreeLeafs& upwardLeafs, RAS_Rasterizer::DrawType drawingMode, bool sort, bool instancing);
+	/** Update the render infos and generate the upward leafs of the sorted mesh slots.
+	 * \return The downward node rendering the mesh slots unsorted, nullptr if they are sorted.
+	 */
+	RAS_DisplayArrayDownwardNode *GenerateTree(RAS_MaterialUpwardNode& upwardRoot, RAS_UpwardTreeLeafs& upwardLeafs,
+			RAS_Rasterizer::DrawType drawingMode, bool sort, bool instancing);
 	void BindUpwardNode(const RAS_DisplayArrayNodeTuple& tuple);
 	void UnbindUpwardNode(const RAS_DisplayArrayNodeTuple& tuple);
 	void RunDownwardNode(const RAS_DisplayArrayNodeTuple& tuple);
@@ -91,6 +91,8 @@ public:
 	virtual mt::mat4 GetViewMat() = 0;
 	virtual mt::mat4 GetWinMat() = 0;
 	virtual int GetShadowLayer() = 0;
+	/// Return the projection and view matrix of the shadow buffer, as bound by BindShadowBuffer.
+	virtual mt::mat4 GetShadowFrustumMatrix() = 0;
 	virtual void BindShadowBuffer(RAS_ICanvas *canvas, KX_Camera *cam, mt::mat3x4& camtrans) = 0;
 	virtual void UnbindShadowBuffer() = 0;
 	virtual Image *GetTextureImage(short texslot) = 0;
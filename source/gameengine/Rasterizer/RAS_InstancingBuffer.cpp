@@ -29,19 +29,25 @@
 #include "RAS_InstancingBuffer.h"
 #include "RAS_Rasterizer.h"
 #include "RAS_MeshUser.h"
+#include "RAS_IPolygonMaterial.h"
 
 extern "C" {
 	// To avoid include BKE_DerivedMesh.h.
 	typedef int (*DMSetMaterial)(int mat_nr, void *attribs);
 	#include "GPU_buffers.h"
+	#include "BLI_task.h"
 }
 
+#include <cstring>
+
 RAS_InstancingBuffer::RAS_InstancingBuffer()
 	:m_vbo(nullptr),
 	m_matrixOffset(nullptr),
 	m_positionOffset(nullptr),
 	m_colorOffset(nullptr),
-	m_stride(sizeof(RAS_InstancingBuffer::InstancingObject))
+	m_stride(sizeof(RAS_InstancingBuffer::InstancingObject)),
+	m_capacity(0),
+	m_uploadNeeded(true)
 {
 	m_matrixOffset = (void *)((InstancingObject *)nullptr)->matrix;
 	m_positionOffset = (void *)((InstancingObject *)nullptr)->position;
@@ -57,10 +63,17 @@ RAS_InstancingBuffer::~RAS_InstancingBuffer()
 
 void RAS_InstancingBuffer::Realloc(unsigned int size)
 {
+	// The draw call uses the number of instances, a larger VBO is reused.
+	if (m_vbo && size <= m_capacity) {
+		return;
+	}
+
 	if (m_vbo) {
 		GPU_buffer_free(m_vbo);
 	}
 	m_vbo = GPU_buffer_alloc(m_stride * size);
+	m_capacity = size;
+	m_uploadNeeded = true;
 }
 
 void RAS_InstancingBuffer::Bind()
@@ -73,16 +86,26 @@ void RAS_InstancingBuffer::Unbind()
 	GPU_buffer_unbind(m_vbo, GPU_BINDING_ARRAY);
 }
 
-void RAS_InstancingBuffer::Update(RAS_Rasterizer *rasty, int drawingmode, RAS_MeshSlotList &meshSlots)
+bool RAS_InstancingBuffer::PackInstances(RAS_Rasterizer *rasty, int drawingmode, const RAS_MeshSlotList& meshSlots,
+		unsigned int start, unsigned int end)
 {
-	InstancingObject *buffer = (InstancingObject *)GPU_buffer_lock_stream(m_vbo, GPU_BINDING_ARRAY);
+	// Billboard and halo matrices depend on the camera and shadow matrices on the scene.
+	const bool reuse = (drawingmode == RAS_IPolyMaterial::RAS_NORMAL);
+	bool modified = false;
+
+	for (unsigned int i = start; i < end; ++i) {
+		RAS_MeshUser *meshUser = meshSlots[i]->m_meshUser;
+		const uint64_t revision = meshUser->GetRevision();
+		if (reuse && m_meshUsers[i] == meshUser && m_revisions[i] == revision) {
+			continue;
+		}
 
-	for (unsigned int i = 0, size = meshSlots.size(); i < size; ++i) {
-		RAS_MeshSlot *ms = meshSlots[i];
-		InstancingObject& data = buffer[i];
+		InstancingObject& data = m_instances[i];
 		float mat[16];
-		rasty->SetClientObject(ms->m_meshUser->GetClientObject());
-		rasty->GetTransform(ms->m_meshUser->GetMatrix(), drawingmode, mat);
+		if (drawingmode == RAS_IPolyMaterial::RAS_SHADOW) {
+			rasty->SetClientObject(meshUser->GetClientObject());
+		}
+		rasty->GetTransform(meshUser->GetMatrix(), drawingmode, mat);
 		data.matrix[0] = mat[0];
 		data.matrix[1] = mat[4];
 		data.matrix[2] = mat[8];
@@ -96,12 +119,73 @@ void RAS_InstancingBuffer::Update(RAS_Rasterizer *rasty, int drawingmode, RAS_Me
 		data.position[1] = mat[13];
 		data.position[2] = mat[14];
 
-		const mt::vec4& color = ms->m_meshUser->GetColor();
+		const mt::vec4& color = meshUser->GetColor();
 		data.color[0] = color[0] * 255.0f;
 		data.color[1] = color[1] * 255.0f;
 		data.color[2] = color[2] * 255.0f;
 		data.color[3] = color[3] * 255.0f;
+
+		m_meshUsers[i] = reuse ? meshUser : nullptr;
+		m_revisions[i] = revision;
+		modified = true;
+	}
+
+	return modified;
+}
+
+void RAS_InstancingBuffer::PackInstancesTask(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	PackRange *range = (PackRange *)taskdata;
+	range->m_modified = range->m_buffer->PackInstances(range->m_rasty, range->m_drawingMode, *range->m_meshSlots,
+			range->m_start, range->m_end);
+}
+
+void RAS_InstancingBuffer::Update(RAS_Rasterizer *rasty, int drawingmode, RAS_MeshSlotList &meshSlots)
+{
+	const unsigned int size = meshSlots.size();
+	bool modified = m_uploadNeeded || (size != m_instances.size());
+
+	m_instances.resize(size);
+	m_meshUsers.resize(size, nullptr);
+	m_revisions.resize(size, 0);
+
+	TaskScheduler *scheduler = rasty->GetTaskScheduler();
+	// The shadow matrices are computed with a ray cast using the rasterizer client object.
+	if (!scheduler || drawingmode == RAS_IPolyMaterial::RAS_SHADOW) {
+		modified |= PackInstances(rasty, drawingmode, meshSlots, 0, size);
+	}
+	else {
+		const unsigned int numThreads = BLI_task_scheduler_num_threads(scheduler);
+		const unsigned int taskSize = std::max(256U, size / (numThreads * 4));
+
+		std::vector<PackRange> ranges;
+		for (unsigned int start = 0; start < size; start += taskSize) {
+			ranges.push_back({this, rasty, drawingmode, &meshSlots, start, std::min(start + taskSize, size), false});
+		}
+
+		if (ranges.size() == 1) {
+			modified |= PackInstances(rasty, drawingmode, meshSlots, 0, size);
+		}
+		else {
+			TaskPool *pool = BLI_task_pool_create(scheduler, nullptr);
+			for (PackRange& range : ranges) {
+				BLI_task_pool_push(pool, PackInstancesTask, &range, false, TASK_PRIORITY_HIGH);
+			}
+			BLI_task_pool_work_and_wait(pool);
+			BLI_task_pool_free(pool);
+
+			for (const PackRange& range : ranges) {
+				modified |= range.m_modified;
+			}
+		}
+	}
+
+	// Upload all the instances at once only if one of them changed.
+	if (modified && size > 0) {
+		InstancingObject *buffer = (InstancingObject *)GPU_buffer_lock_stream(m_vbo, GPU_BINDING_ARRAY);
+		memcpy(buffer, m_instances.data(), sizeof(InstancingObject) * size);
+		GPU_buffer_unlock(m_vbo, GPU_BINDING_ARRAY);
 	}
 
-	GPU_buffer_unlock(m_vbo, GPU_BINDING_ARRAY);
+	m_uploadNeeded = false;
 }
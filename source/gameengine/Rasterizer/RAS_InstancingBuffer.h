@@ -32,8 +32,10 @@
 #include "RAS_MeshSlot.h"
 
 class RAS_Rasterizer;
+class RAS_MeshUser;
 
 struct GPUBuffer;
+struct TaskPool;
 
 class RAS_InstancingBuffer
 {
@@ -47,6 +49,8 @@ class RAS_InstancingBuffer
 	void *m_colorOffset;
 	/// The instance structure stride in the VBO.
 	unsigned int m_stride;
+	/// Number of instances allocated in the VBO.
+	unsigned int m_capacity;
 
 	/// Structure used to store object info for geometry instancing objects render.
 	struct InstancingObject
@@ -56,18 +60,50 @@ class RAS_InstancingBuffer
 		unsigned char color[4];
 	};
 
+	/** Instances packed during the previous update, kept to repack only the instances
+	 * of modified mesh users and to skip the upload when nothing changed.
+	 */
+	std::vector<InstancingObject> m_instances;
+	/// Mesh user packed in each instance, nullptr when the instance can't be reused.
+	std::vector<RAS_MeshUser *> m_meshUsers;
+	/// Revision of the mesh user when its instance was packed.
+	std::vector<uint64_t> m_revisions;
+	/// True when the VBO doesn't contain m_instances.
+	bool m_uploadNeeded;
+
+	/// Range of instances packed by a task.
+	struct PackRange
+	{
+		RAS_InstancingBuffer *m_buffer;
+		RAS_Rasterizer *m_rasty;
+		int m_drawingMode;
+		const RAS_MeshSlotList *m_meshSlots;
+		unsigned int m_start;
+		unsigned int m_end;
+		bool m_modified;
+	};
+
+	/** Pack the instances of mesh slots [start, end[, the instances of unmodified mesh users
+	 * are reused for normal drawing mode.
+	 * \return True if an instance was packed.
+	 */
+	bool PackInstances(RAS_Rasterizer *rasty, int drawingmode, const RAS_MeshSlotList& meshSlots,
+			unsigned int start, unsigned int end);
+	static void PackInstancesTask(TaskPool *pool, void *taskdata, int threadid);
+
 public:
 	RAS_InstancingBuffer();
 	virtual ~RAS_InstancingBuffer();
 
-	/// Realloc the VBO.
+	/// Realloc the VBO if it can't contain size instances.
 	void Realloc(unsigned int size);
 	/// Bind the VBO before work on it.
 	void Bind();
 	/// Unbind the VBO after work on it.
 	void Unbind();
 
-	/** Allocate the VBO and fill it with a InstancingObject per mesh slots.
+	/** Fill the VBO with a InstancingObject per mesh slots, only the modified instances are packed
+	 * and the VBO is uploaded only if an instance changed.
 	 * \param rasty Rasterizer used to compute the mesh slot matrix, useful for billboard material.
 	 * \param drawingmode The material drawing mode used to detect a billboard/halo/shadow material.
 	 * \param meshSlots The list of all non-culled and visible mesh slots (= game object).
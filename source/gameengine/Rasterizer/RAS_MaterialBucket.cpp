@@ -48,7 +48,6 @@
 
 RAS_MaterialBucket::RAS_MaterialBucket(RAS_IPolyMaterial *mat)
 	:m_material(mat),
-	m_downwardNode(this, &m_nodeData, &RAS_MaterialBucket::BindNode, &RAS_MaterialBucket::UnbindNode),
 	m_upwardNode(this, &m_nodeData, &RAS_MaterialBucket::BindNode, &RAS_MaterialBucket::UnbindNode)
 {
 	m_nodeData.m_material = m_material;
@@ -90,9 +89,10 @@ bool RAS_MaterialBucket::UseInstancing() const
 
 void RAS_MaterialBucket::RemoveActiveMeshSlots()
 {
-	for (RAS_DisplayArrayBucket *arrayBucket : m_displayArrayBucketList) {
+	for (RAS_DisplayArrayBucket *arrayBucket : m_activeDisplayArrayBuckets) {
 		arrayBucket->RemoveActiveMeshSlots();
 	}
+	m_activeDisplayArrayBuckets.clear();
 }
 
 void RAS_MaterialBucket::ActivateMaterial(RAS_Rasterizer *rasty)
@@ -105,19 +105,47 @@ void RAS_MaterialBucket::DesactivateMaterial(RAS_Rasterizer *rasty)
 	m_material->Desactivate(rasty);
 }
 
+RAS_MaterialBucket::RetainedTree& RAS_MaterialBucket::GetRetainedTree(unsigned int pass)
+{
+	for (RetainedTree& tree : m_retainedTrees) {
+		if (tree.m_pass == pass) {
+			return tree;
+		}
+	}
+
+	m_retainedTrees.push_back({pass, RAS_DisplayArrayBucketList(), false,
+			RAS_MaterialDownwardNode(this, &m_nodeData, &RAS_MaterialBucket::BindNode, &RAS_MaterialBucket::UnbindNode)});
+	return m_retainedTrees.back();
+}
+
 void RAS_MaterialBucket::GenerateTree(RAS_ManagerDownwardNode& downwardRoot, RAS_ManagerUpwardNode& upwardRoot,
-		RAS_UpwardTreeLeafs& upwardLeafs, RAS_Rasterizer::DrawType drawingMode, bool sort)
+		RAS_UpwardTreeLeafs& upwardLeafs, RAS_Rasterizer::DrawType drawingMode, bool sort, unsigned int pass)
 {
-	if (m_displayArrayBucketList.empty()) {
+	if (m_activeDisplayArrayBuckets.empty()) {
 		return;
 	}
 
+	/* Replay the tree of the previous render of this pass if the same display array buckets are active,
+	 * a custom shader can disable the instancing in the meantime. */
 	const bool instancing = UseInstancing();
-	for (RAS_DisplayArrayBucket *displayArrayBucket : m_displayArrayBucketList) {
-		displayArrayBucket->GenerateTree(m_downwardNode, m_upwardNode, upwardLeafs, drawingMode, sort, instancing);
+	RetainedTree& tree = GetRetainedTree(pass);
+	const bool replay = (tree.m_instancing == instancing && tree.m_displayArrayBuckets == m_activeDisplayArrayBuckets);
+	if (!replay) {
+		tree.m_downwardNode.Clear();
+		tree.m_displayArrayBuckets = m_activeDisplayArrayBuckets;
+		tree.m_instancing = instancing;
+	}
+
+	// The render infos and the sorted leafs depend on the mesh slots and are always updated.
+	for (RAS_DisplayArrayBucket *displayArrayBucket : m_activeDisplayArrayBuckets) {
+		RAS_DisplayArrayDownwardNode *node = displayArrayBucket->GenerateTree(m_upwardNode, upwardLeafs, drawingMode,
+				sort, instancing);
+		if (!replay && node) {
+			tree.m_downwardNode.AddChild(node);
+		}
 	}
 
-	downwardRoot.AddChild(&m_downwardNode);
+	downwardRoot.AddChild(&tree.m_downwardNode);
 
 	if (sort) {
 		m_upwardNode.SetParent(&upwardRoot);
@@ -144,6 +172,11 @@ void RAS_MaterialBucket::UnbindNode(const RAS_MaterialNodeTuple& tuple)
 	}
 }
 
+void RAS_MaterialBucket::ActivateDisplayArrayBucket(RAS_DisplayArrayBucket *bucket)
+{
+	m_activeDisplayArrayBuckets.push_back(bucket);
+}
+
 void RAS_MaterialBucket::AddDisplayArrayBucket(RAS_DisplayArrayBucket *bucket)
 {
 	m_displayArrayBucketList.push_back(bucket);
@@ -152,6 +185,9 @@ void RAS_MaterialBucket::AddDisplayArrayBucket(RAS_DisplayArrayBucket *bucket)
 void RAS_MaterialBucket::RemoveDisplayArrayBucket(RAS_DisplayArrayBucket *bucket)
 {
 	CM_ListRemoveIfFound(m_displayArrayBucketList, bucket);
+	CM_ListRemoveIfFound(m_activeDisplayArrayBuckets, bucket);
+	// The retained trees could use the removed display array bucket.
+	m_retainedTrees.clear();
 }
 
 RAS_DisplayArrayBucketList& RAS_MaterialBucket::GetDisplayArrayBucketList()
@@ -171,6 +207,13 @@ void RAS_MaterialBucket::MoveDisplayArrayBucket(RAS_MeshMaterial *meshmat, RAS_M
 
 		displayArrayBucket->ChangeMaterialBucket(bucket);
 		bucket->AddDisplayArrayBucket(displayArrayBucket);
+		// Keep the mesh slots activated before the change rendered in the new bucket.
+		if (CM_ListRemoveIfFound(m_activeDisplayArrayBuckets, displayArrayBucket)) {
+			bucket->ActivateDisplayArrayBucket(displayArrayBucket);
+		}
 		dit = m_displayArrayBucketList.erase(dit);
+
+		m_retainedTrees.clear();
+		bucket->m_retainedTrees.clear();
 	}
 }
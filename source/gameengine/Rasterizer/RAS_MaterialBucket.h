@@ -58,14 +58,19 @@ public:
 	void ActivateMaterial(RAS_Rasterizer *rasty);
 	void DesactivateMaterial(RAS_Rasterizer *rasty);
 
-	// Render nodes.
+	/** Generate the render nodes of the active display array buckets.
+	 * \param pass The index of the render pass, identifying the tree retained for the next renders.
+	 */
 	void GenerateTree(RAS_ManagerDownwardNode& downwardRoot, RAS_ManagerUpwardNode& upwardRoot,
-			RAS_UpwardTreeLeafs& upwardLeafs, RAS_Rasterizer::DrawType drawingMode, bool sort);
+			RAS_UpwardTreeLeafs& upwardLeafs, RAS_Rasterizer::DrawType drawingMode, bool sort, unsigned int pass);
 	void BindNode(const RAS_MaterialNodeTuple& tuple);
 	void UnbindNode(const RAS_MaterialNodeTuple& tuple);
 
 	void RemoveActiveMeshSlots();
 
+	/// Register a display array bucket owning active mesh slots for the current render.
+	void ActivateDisplayArrayBucket(RAS_DisplayArrayBucket *bucket);
+
 	void AddDisplayArrayBucket(RAS_DisplayArrayBucket *bucket);
 	void RemoveDisplayArrayBucket(RAS_DisplayArrayBucket *bucket);
 
@@ -74,12 +79,32 @@ public:
 	void MoveDisplayArrayBucket(RAS_MeshMaterial *meshmat, RAS_MaterialBucket *bucket);
 
 private:
+	/// Downward tree of a render pass kept between the renders.
+	struct RetainedTree
+	{
+		unsigned int m_pass;
+		/// Active display array buckets and instancing used to generate the tree.
+		RAS_DisplayArrayBucketList m_displayArrayBuckets;
+		bool m_instancing;
+		RAS_MaterialDownwardNode m_downwardNode;
+	};
+
 	RAS_IPolyMaterial *m_material;
 	RAS_DisplayArrayBucketList m_displayArrayBucketList;
+	/** Display array buckets with active mesh slots, filled while the mesh slots are activated.
+	 * The render tree is generated and cleared from this list only, its cost depends
+	 * on the visible meshes and not on all the meshes of the scene.
+	 */
+	RAS_DisplayArrayBucketList m_activeDisplayArrayBuckets;
 
 	RAS_MaterialNodeData m_nodeData;
-	RAS_MaterialDownwardNode m_downwardNode;
+	/** The downward children of the material node only depend on the active display array buckets,
+	 * the tree of each pass is replayed while they don't change.
+	 */
+	std::vector<RetainedTree> m_retainedTrees;
 	RAS_MaterialUpwardNode m_upwardNode;
+
+	RetainedTree& GetRetainedTree(unsigned int pass);
 };
 
 #endif  // __RAS_MATERIAL_BUCKET_H__
@@ -31,9 +31,12 @@
 #include "RAS_BoundingBox.h"
 #include "RAS_BatchGroup.h"
 
+std::atomic<uint64_t> RAS_MeshUser::m_revisionCounter(0);
+
 RAS_MeshUser::RAS_MeshUser(void *clientobj, RAS_BoundingBox *boundingBox)
 	:m_frontFace(true),
 	m_color(mt::zero4),
+	m_revision(++m_revisionCounter),
 	m_boundingBox(boundingBox),
 	m_clientObject(clientobj),
 	m_batchGroup(nullptr)
@@ -77,6 +80,11 @@ float *RAS_MeshUser::GetMatrix()
 	return m_matrix;
 }
 
+uint64_t RAS_MeshUser::GetRevision() const
+{
+	return m_revision;
+}
+
 RAS_BoundingBox *RAS_MeshUser::GetBoundingBox() const
 {
 	return m_boundingBox;
@@ -104,7 +112,21 @@ void RAS_MeshUser::SetFrontFace(bool frontFace)
 
 void RAS_MeshUser::SetColor(const mt::vec4& color)
 {
-	m_color = color;
+	if (m_color != color) {
+		m_color = color;
+		UpdateRevision();
+	}
+}
+
+void RAS_MeshUser::SetMatrix(const mt::mat3x4& trans)
+{
+	trans.PackFromAffineTransform(m_matrix);
+	UpdateRevision();
+}
+
+void RAS_MeshUser::UpdateRevision()
+{
+	m_revision = ++m_revisionCounter;
 }
 
 void RAS_MeshUser::SetBatchGroup(RAS_BatchGroup *batchGroup)
@@ -31,6 +31,8 @@
 
 #include "RAS_MeshSlot.h"
 
+#include <atomic>
+
 class RAS_BoundingBox;
 class RAS_BatchGroup;
 
@@ -43,6 +45,11 @@ private:
 	mt::vec4 m_color;
 	/// Object transformation matrix.
 	float m_matrix[16];
+	/** Stamped from a counter shared by all the mesh users each time the matrix or the color changes,
+	 * used to repack only modified instances. A mesh user allocated at the address of a deleted one
+	 * never gets a revision already used.
+	 */
+	uint64_t m_revision;
 	/// Bounding box corresponding to a mesh or deformer.
 	RAS_BoundingBox *m_boundingBox;
 	/// Client object owner of this mesh user.
@@ -52,6 +59,11 @@ private:
 	/// Possible batching groups shared between mesh users.
 	RAS_BatchGroup *m_batchGroup;
 
+	/// Last revision stamped to a mesh user.
+	static std::atomic<uint64_t> m_revisionCounter;
+
+	void UpdateRevision();
+
 public:
 	RAS_MeshUser(void *clientobj, RAS_BoundingBox *boundingBox);
 	virtual ~RAS_MeshUser();
@@ -60,6 +72,7 @@ public:
 	bool GetFrontFace() const;
 	const mt::vec4& GetColor() const;
 	float *GetMatrix();
+	uint64_t GetRevision() const;
 	RAS_BoundingBox *GetBoundingBox() const;
 	void *GetClientObject() const;
 	RAS_MeshSlotList& GetMeshSlots();
@@ -67,6 +80,7 @@ public:
 
 	void SetFrontFace(bool frontFace);
 	void SetColor(const mt::vec4& color);
+	void SetMatrix(const mt::mat3x4& trans);
 	void SetBatchGroup(RAS_BatchGroup *batchGroup);
 
 	void ActivateMeshSlots();
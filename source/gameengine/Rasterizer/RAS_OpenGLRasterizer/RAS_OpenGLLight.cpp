@@ -54,7 +54,8 @@ RAS_OpenGLLight::~RAS_OpenGLLight()
 	KX_LightObject *kxlight = (KX_LightObject *)m_light;
 	Lamp *la = (Lamp *)kxlight->GetBlenderObject()->data;
 
-	if ((lamp = GetGPULamp())) {
+	// Getting the GPU lamp could create its shadow buffer.
+	if (!m_rasterizer->IsHeadless() && (lamp = GetGPULamp())) {
 		float obmat[4][4] = {{0}};
 		GPU_lamp_update(lamp, 0, 0, obmat);
 		GPU_lamp_update_distance(lamp, la->dist, la->att1, la->att2, la->coeff_const, la->coeff_lin, la->coeff_quad);
@@ -224,6 +225,17 @@ int RAS_OpenGLLight::GetShadowLayer()
 		return 0;
 }
 
+mt::mat4 RAS_OpenGLLight::GetShadowFrustumMatrix()
+{
+	GPULamp *lamp = GetGPULamp();
+	if (lamp) {
+		// Compute the view matrix like GPU_lamp_shadow_buffer_bind without binding the buffer.
+		GPU_lamp_update_buffer_mats(lamp);
+		return mt::mat4(GPU_lamp_get_winmat(lamp)) * mt::mat4(GPU_lamp_get_viewmat(lamp));
+	}
+	return mt::mat4::Identity();
+}
+
 void RAS_OpenGLLight::BindShadowBuffer(RAS_ICanvas *canvas, KX_Camera *cam, mt::mat3x4& camtrans)
 {
 	GPULamp *lamp;
@@ -57,6 +57,7 @@ public:
 	mt::mat4 GetWinMat();
 	mt::mat4 GetShadowMatrix();
 	int GetShadowLayer();
+	mt::mat4 GetShadowFrustumMatrix();
 	void BindShadowBuffer(RAS_ICanvas *canvas, KX_Camera *cam, mt::mat3x4& camtrans);
 	void UnbindShadowBuffer();
 	Image *GetTextureImage(short texslot);
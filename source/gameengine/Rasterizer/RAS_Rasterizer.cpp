@@ -192,7 +192,7 @@ RAS_Rasterizer::OffScreenType RAS_Rasterizer::NextRenderOffScreen(RAS_Rasterizer
 	}
 }
 
-RAS_Rasterizer::RAS_Rasterizer()
+RAS_Rasterizer::RAS_Rasterizer(bool headless)
 	:m_time(0.0f),
 	m_ambient(mt::zero3),
 	m_viewmatrix(mt::mat4::Identity()),
@@ -210,12 +210,19 @@ RAS_Rasterizer::RAS_Rasterizer()
 	m_motionblurvalue(-1.0f),
 	m_clientobject(nullptr),
 	m_auxilaryClientInfo(nullptr),
+	m_taskScheduler(nullptr),
 	m_drawingmode(RAS_TEXTURED),
 	m_shadowMode(RAS_SHADOW_NONE),
 	m_invertFrontFace(false),
 	m_last_frontface(true),
-	m_overrideShader(RAS_OVERRIDE_SHADER_NONE)
+	m_overrideShader(RAS_OVERRIDE_SHADER_NONE),
+	m_headless(headless)
 {
+	if (m_headless) {
+		m_numgllights = 0;
+		return;
+	}
+
 	m_impl.reset(new RAS_OpenGLRasterizer(this));
 
 	m_numgllights = m_impl->GetNumLights();
@@ -227,6 +234,11 @@ RAS_Rasterizer::~RAS_Rasterizer()
 {
 }
 
+bool RAS_Rasterizer::IsHeadless() const
+{
+	return m_headless;
+}
+
 void RAS_Rasterizer::Enable(RAS_Rasterizer::EnableBit bit)
 {
 	m_impl->Enable(bit);
@@ -264,6 +276,10 @@ void RAS_Rasterizer::SetFog(short type, float start, float dist, float intensity
 
 void RAS_Rasterizer::Init()
 {
+	if (m_headless) {
+		return;
+	}
+
 	GPU_state_init();
 
 	Disable(RAS_BLEND);
@@ -280,6 +296,10 @@ void RAS_Rasterizer::Init()
 
 void RAS_Rasterizer::Exit()
 {
+	if (m_headless) {
+		return;
+	}
+
 	Enable(RAS_CULL_FACE);
 	Enable(RAS_DEPTH_TEST);
 
@@ -1455,6 +1475,16 @@ void RAS_Rasterizer::SetAuxilaryClientInfo(void *inf)
 	m_auxilaryClientInfo = inf;
 }
 
+TaskScheduler *RAS_Rasterizer::GetTaskScheduler() const
+{
+	return m_taskScheduler;
+}
+
+void RAS_Rasterizer::SetTaskScheduler(TaskScheduler *scheduler)
+{
+	m_taskScheduler = scheduler;
+}
+
 void RAS_Rasterizer::PrintHardwareInfo()
 {
 	m_impl->PrintHardwareInfo();
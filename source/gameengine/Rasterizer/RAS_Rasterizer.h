@@ -57,6 +57,7 @@ class RAS_ILightObject;
 class SCA_IScene;
 class RAS_ISync;
 struct KX_ClientObjectInfo;
+struct TaskScheduler;
 class KX_RayCast;
 
 struct GPUShader;
@@ -308,6 +309,8 @@ private:
 	/* Render tools */
 	void *m_clientobject;
 	void *m_auxilaryClientInfo;
+	/// Task scheduler of the engine used to split render data update.
+	TaskScheduler *m_taskScheduler;
 	std::vector<RAS_OpenGLLight *> m_lights;
 	int m_lastlightlayer;
 	bool m_lastlighting;
@@ -325,6 +328,9 @@ private:
 
 	OverrideShaderType m_overrideShader;
 
+	/// The rasterizer never uses the GPU, no implementation is created.
+	bool m_headless;
+
 	std::unique_ptr<RAS_OpenGLRasterizer> m_impl;
 
 	/// Initialize custom shader interface containing uniform location.
@@ -334,9 +340,16 @@ private:
 	GPUShader *GetOverrideGPUShader(OverrideShaderType type);
 
 public:
-	RAS_Rasterizer();
+	/** Create the rasterizer.
+	 * \param headless Never use the GPU, used to run the game without any render.
+	 * Nothing must be rendered with a headless rasterizer.
+	 */
+	RAS_Rasterizer(bool headless = false);
 	virtual ~RAS_Rasterizer();
 
+	/// Return true when the rasterizer doesn't use the GPU.
+	bool IsHeadless() const;
+
 	/**
 	 * Enable capability
 	 * \param bit Enable bit
@@ -710,6 +723,9 @@ public:
 
 	void SetAuxilaryClientInfo(void *inf);
 
+	TaskScheduler *GetTaskScheduler() const;
+	void SetTaskScheduler(TaskScheduler *scheduler);
+
 	/**
 	 * Prints information about what the hardware supports.
 	 */
@@ -1,5 +1,11 @@
 #include "SG_Frustum.h"
 
+#include <algorithm>
+
+#ifdef __SSE__
+#  include <xmmintrin.h>
+#endif
+
 SG_Frustum::SG_Frustum(const mt::mat4& matrix)
 	:m_matrix(matrix)
 {
@@ -66,6 +72,60 @@ SG_Frustum::TestType SG_Frustum::SphereInsideFrustum(const mt::vec3& center, flo
 	return INSIDE;
 }
 
+void SG_Frustum::SpheresInsideFrustum(const float *centersX, const float *centersY, const float *centersZ,
+		const float *radius, unsigned int count, TestType *results) const
+{
+	/* Unlike SphereInsideFrustum all the planes are tested, a sphere outside of
+	 * any plane is outside, else a sphere intersecting any plane is intersecting. */
+#ifdef __SSE__
+	__m128 planes[6][4];
+	for (unsigned short i = 0; i < 6; ++i) {
+		for (unsigned short j = 0; j < 4; ++j) {
+			planes[i][j] = _mm_set1_ps(m_planes[i][j]);
+		}
+	}
+
+	for (unsigned int i = 0; i < count; i += 4) {
+		const __m128 x = _mm_loadu_ps(centersX + i);
+		const __m128 y = _mm_loadu_ps(centersY + i);
+		const __m128 z = _mm_loadu_ps(centersZ + i);
+		const __m128 r = _mm_loadu_ps(radius + i);
+		const __m128 nr = _mm_sub_ps(_mm_setzero_ps(), r);
+
+		__m128 outside = _mm_setzero_ps();
+		__m128 intersect = _mm_setzero_ps();
+		for (unsigned short j = 0; j < 6; ++j) {
+			const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes[j][0], x), _mm_mul_ps(planes[j][1], y)),
+					_mm_add_ps(_mm_mul_ps(planes[j][2], z), planes[j][3]));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, nr));
+			// Only meaningful when the sphere is not outside, in this case distance >= -radius.
+			intersect = _mm_or_ps(intersect, _mm_cmple_ps(distance, r));
+		}
+
+		const int outsideMask = _mm_movemask_ps(outside);
+		const int intersectMask = _mm_movemask_ps(intersect);
+		const unsigned int size = std::min(count - i, 4u);
+		for (unsigned int j = 0; j < size; ++j) {
+			const int bit = (1 << j);
+			results[i + j] = (outsideMask & bit) ? OUTSIDE : ((intersectMask & bit) ? INTERSECT : INSIDE);
+		}
+	}
+#else
+	for (unsigned int i = 0; i < count; ++i) {
+		const mt::vec3 center(centersX[i], centersY[i], centersZ[i]);
+		bool outside = false;
+		bool intersect = false;
+		for (const mt::vec4& plane : m_planes) {
+			const float distance = planeSide(plane, center);
+			outside |= (distance < -radius[i]);
+			intersect |= (distance <= radius[i]);
+		}
+
+		results[i] = outside ? OUTSIDE : (intersect ? INTERSECT : INSIDE);
+	}
+#endif
+}
+
 SG_Frustum::TestType SG_Frustum::BoxInsideFrustum(const std::array<mt::vec3, 8>& box) const
 {
 	unsigned short insidePlane = 0;
@@ -31,6 +31,12 @@ public:
 
 	TestType PointInsideFrustum(const mt::vec3& point) const;
 	TestType SphereInsideFrustum(const mt::vec3& center, float radius) const;
+	/** Test a batch of spheres stored per component, each array must be
+	 * allocated for count rounded up to a multiple of 4 elements.
+	 * \param results The test result of each sphere.
+	 */
+	void SpheresInsideFrustum(const float *centersX, const float *centersY, const float *centersZ,
+			const float *radius, unsigned int count, TestType *results) const;
 	TestType BoxInsideFrustum(const std::array<mt::vec3, 8>& box) const;
 	TestType AabbInsideFrustum(const mt::vec3& min, const mt::vec3& max, const mt::mat4& mat) const;
 	TestType FrustumInsideFrustum(const SG_Frustum& frustum) const;
@@ -397,6 +397,11 @@ void SG_Node::SetModified()
 	ActivateScheduleUpdateCallback();
 }
 
+void SG_Node::SetDirty(DirtyFlag flag)
+{
+	m_dirty |= flag;
+}
+
 void SG_Node::ClearDirty(DirtyFlag flag)
 {
 	m_dirty &= ~flag;
@@ -291,6 +291,7 @@ public:
 
 	void ClearModified();
 	void SetModified();
+	void SetDirty(DirtyFlag flag);
 	void ClearDirty(DirtyFlag flag);
 
 	/**
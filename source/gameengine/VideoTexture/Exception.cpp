@@ -37,11 +37,12 @@
 
 
 // exception identificators
-ExceptionID ErrGeneral, ErrNotFound;
+ExceptionID ErrGeneral, ErrNotFound, RenderNotAvail;
 
 // exception descriptions
 ExpDesc errGenerDesc(ErrGeneral, "General Error");
 ExpDesc errNFoundDesc(ErrNotFound, "Error description not found");
+ExpDesc RenderNotAvailDesc(RenderNotAvail, "Render is not available in headless mode");
 
 
 
@@ -209,6 +210,7 @@ void registerAllExceptions(void)
 {
 	errGenerDesc.registerDesc();
 	errNFoundDesc.registerDesc();
+	RenderNotAvailDesc.registerDesc();
 	TextureNotAvailDesc.registerDesc();
 	MaterialNotAvailDesc.registerDesc();
 	ImageSizesNotMatchDesc.registerDesc();
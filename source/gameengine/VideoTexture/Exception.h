@@ -71,7 +71,7 @@ class Exception;
 
 
 // exception identificators
-extern ExceptionID ErrGeneral, ErrNotFound;
+extern ExceptionID ErrGeneral, ErrNotFound, RenderNotAvail;
 
 
 // result type
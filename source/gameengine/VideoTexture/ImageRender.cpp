@@ -476,6 +476,11 @@ static int ImageRender_init(PyObject *pySelf, PyObject *args, PyObject *kwds)
 		return -1;
 	try
 	{
+		// The render uses an off screen.
+		if (KX_GetActiveEngine()->GetRasterizer()->IsHeadless()) {
+			THRWEXCP(RenderNotAvail, S_OK);
+		}
+
 		// get scene pointer
 		KX_Scene * scenePtr (nullptr);
 		if (!PyObject_TypeCheck(scene, &KX_Scene::Type)) {
@@ -742,6 +747,11 @@ static int ImageMirror_init(PyObject *pySelf, PyObject *args, PyObject *kwds)
 		return -1;
 	try
 	{
+		// The render uses an off screen.
+		if (KX_GetActiveEngine()->GetRasterizer()->IsHeadless()) {
+			THRWEXCP(RenderNotAvail, S_OK);
+		}
+
 		// get scene pointer
 		KX_Scene * scenePtr (nullptr);
 		if (scene != nullptr && PyObject_TypeCheck(scene, &KX_Scene::Type))
@@ -425,6 +425,25 @@ int ImageViewport_setCaptureSize(PyImage *self, PyObject *value, void *closure)
 }
 
 // methods structure
+// object initialization
+static int ImageViewport_init(PyObject *pySelf, PyObject *args, PyObject *kwds)
+{
+	try
+	{
+		// The viewport is read from the frame buffer.
+		if (KX_GetActiveEngine()->GetRasterizer()->IsHeadless()) {
+			THRWEXCP(RenderNotAvail, S_OK);
+		}
+	}
+	catch (Exception & exp)
+	{
+		exp.report();
+		return -1;
+	}
+
+	return Image_init<ImageViewport>(pySelf, args, kwds);
+}
+
 static PyMethodDef imageViewportMethods[] =
 { // methods from ImageBase class
 	{"refresh", (PyCFunction)Image_refresh, METH_VARARGS, "Refresh image - invalidate its current content"},
@@ -487,7 +506,7 @@ PyTypeObject ImageViewportType = {
 	0,                         /* tp_descr_get */
 	0,                         /* tp_descr_set */
 	0,                         /* tp_dictoffset */
-	(initproc)Image_init<ImageViewport>,     /* tp_init */
+	(initproc)ImageViewport_init,     /* tp_init */
 	0,                         /* tp_alloc */
 	Image_allocNew,           /* tp_new */
 };
@@ -300,6 +300,11 @@ static int Texture_init(PyObject *self, PyObject *args, PyObject *kwds)
 		// process polygon material or blender material
 		try
 		{
+			// The texture is an OpenGL texture.
+			if (KX_GetActiveEngine()->GetRasterizer()->IsHeadless()) {
+				THRWEXCP(RenderNotAvail, S_OK);
+			}
+
 			tex->m_scene = gameObj->GetScene();
 			// get pointer to texture image
 			RAS_IPolyMaterial *mat = getMaterial(gameObj, matID);
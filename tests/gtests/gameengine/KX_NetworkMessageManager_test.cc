@@ -0,0 +1,116 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "KX_NetworkMessageManager.h"
+
+#include <string>
+#include <vector>
+
+static void send_message(KX_NetworkMessageManager& manager, const std::string& to, const std::string& subject,
+		const std::string& body)
+{
+	KX_NetworkMessageManager::Message message;
+	message.to = manager.GetId(to);
+	message.from = nullptr;
+	message.subject = manager.GetId(subject);
+	message.body = body;
+	manager.AddMessage(std::move(message));
+}
+
+static std::vector<std::string> received_bodies(const KX_NetworkMessageManager& manager, const std::string& to,
+		const std::string& subject)
+{
+	const KX_NetworkMessageManager::Id subjectId = subject.empty() ? KX_NetworkMessageManager::NO_ID : manager.FindId(subject);
+	const KX_NetworkMessageManager::MessageRanges ranges = manager.GetMessages(manager.FindId(to), subjectId);
+
+	std::vector<std::string> bodies;
+	for (const KX_NetworkMessageManager::Message& message : ranges.noReceiver) {
+		bodies.push_back(message.body);
+	}
+	for (const KX_NetworkMessageManager::Message& message : ranges.receiver) {
+		bodies.push_back(message.body);
+	}
+	EXPECT_EQ(ranges.size(), bodies.size());
+
+	return bodies;
+}
+
+TEST(KX_NetworkMessageManager, InternedIds)
+{
+	KX_NetworkMessageManager manager;
+
+	EXPECT_EQ(KX_NetworkMessageManager::NO_ID, manager.GetId(""));
+	const KX_NetworkMessageManager::Id id = manager.GetId("Cube");
+	EXPECT_EQ(id, manager.GetId("Cube"));
+	EXPECT_EQ(id, manager.FindId("Cube"));
+	EXPECT_EQ("Cube", manager.GetName(id));
+	EXPECT_EQ(KX_NetworkMessageManager::INVALID_ID, manager.FindId("Sphere"));
+}
+
+TEST(KX_NetworkMessageManager, MessageIdsFreed)
+{
+	KX_NetworkMessageManager manager;
+
+	const KX_NetworkMessageManager::Id cube = manager.GetId("Cube");
+	EXPECT_EQ(cube, manager.GetMessageId("Cube"));
+	const KX_NetworkMessageManager::Id hit = manager.GetMessageId("hit");
+
+	KX_NetworkMessageManager::Message message;
+	message.to = cube;
+	message.from = nullptr;
+	message.subject = hit;
+	message.body = "1";
+	manager.AddMessage(std::move(message));
+
+	// Still used by the messages of the last frame.
+	manager.ClearMessages();
+	EXPECT_EQ(hit, manager.FindId("hit"));
+	EXPECT_EQ(1, manager.GetMessages(cube, hit).size());
+
+	manager.ClearMessages();
+	EXPECT_EQ(KX_NetworkMessageManager::INVALID_ID, manager.FindId("hit"));
+	EXPECT_EQ(cube, manager.FindId("Cube"));
+
+	// The freed id is reused.
+	EXPECT_EQ(hit, manager.GetMessageId("die"));
+	EXPECT_EQ("die", manager.GetName(hit));
+}
+
+TEST(KX_NetworkMessageManager, MessagesDeliveredNextFrame)
+{
+	KX_NetworkMessageManager manager;
+
+	send_message(manager, "Cube", "hit", "1");
+	EXPECT_TRUE(received_bodies(manager, "Cube", "hit").empty());
+
+	manager.ClearMessages();
+	EXPECT_EQ(std::vector<std::string>({"1"}), received_bodies(manager, "Cube", "hit"));
+
+	manager.ClearMessages();
+	EXPECT_TRUE(received_bodies(manager, "Cube", "hit").empty());
+}
+
+TEST(KX_NetworkMessageManager, FilterByReceiverAndSubject)
+{
+	KX_NetworkMessageManager manager;
+
+	send_message(manager, "Cube", "hit", "1");
+	send_message(manager, "", "hit", "2");
+	send_message(manager, "Sphere", "hit", "3");
+	send_message(manager, "Cube", "die", "4");
+	send_message(manager, "Cube", "hit", "5");
+	send_message(manager, "", "", "6");
+	manager.ClearMessages();
+
+	// Broadcast messages first, then the receiver messages in sending order.
+	EXPECT_EQ(std::vector<std::string>({"2", "1", "5"}), received_bodies(manager, "Cube", "hit"));
+	EXPECT_EQ(std::vector<std::string>({"4"}), received_bodies(manager, "Cube", "die"));
+	EXPECT_EQ(std::vector<std::string>({"2", "3"}), received_bodies(manager, "Sphere", "hit"));
+	EXPECT_EQ(std::vector<std::string>({"2"}), received_bodies(manager, "Cone", "hit"));
+	EXPECT_TRUE(received_bodies(manager, "Sphere", "die").empty());
+
+	// An empty subject receives all the subjects, grouped by subject.
+	EXPECT_EQ(std::vector<std::string>({"6", "2", "1", "5", "4"}), received_bodies(manager, "Cube", ""));
+	EXPECT_EQ(std::vector<std::string>({"6", "2", "3"}), received_bodies(manager, "Sphere", ""));
+}
@@ -0,0 +1,69 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "SG_Frustum.h"
+
+extern "C" {
+#include "PIL_time_utildefines.h"
+}
+
+#include <random>
+#include <vector>
+
+/* Number of spheres tested per pass, matching a crowded scene. */
+#define SPHERES_NUM 50000
+/* Number of culling passes, e.g one camera and a few shadow lights over many frames. */
+#define PASSES_NUM 100
+
+TEST(SG_Frustum, SpheresInsideFrustumPerformance)
+{
+	const mt::mat4 projection = mt::mat4::Perspective(1.0f, 1.5f, 0.1f, 100.0f);
+	const SG_Frustum frustum(projection);
+
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+	std::uniform_real_distribution<float> size(0.01f, 5.0f);
+
+	std::vector<mt::vec3> centers(SPHERES_NUM);
+	std::vector<float> radius(SPHERES_NUM);
+	std::vector<float> centersX(SPHERES_NUM);
+	std::vector<float> centersY(SPHERES_NUM);
+	std::vector<float> centersZ(SPHERES_NUM);
+	for (unsigned int i = 0; i < SPHERES_NUM; ++i) {
+		centers[i] = mt::vec3(position(generator), position(generator), position(generator));
+		radius[i] = size(generator);
+		centersX[i] = centers[i].x;
+		centersY[i] = centers[i].y;
+		centersZ[i] = centers[i].z;
+	}
+
+	std::vector<SG_Frustum::TestType> results(SPHERES_NUM);
+	unsigned int scalarInside = 0;
+	unsigned int batchInside = 0;
+
+	TIMEIT_START(scalar_spheres);
+	for (unsigned int pass = 0; pass < PASSES_NUM; ++pass) {
+		for (unsigned int i = 0; i < SPHERES_NUM; ++i) {
+			results[i] = frustum.SphereInsideFrustum(centers[i], radius[i]);
+		}
+	}
+	TIMEIT_END(scalar_spheres);
+
+	for (SG_Frustum::TestType result : results) {
+		scalarInside += (result == SG_Frustum::INSIDE);
+	}
+
+	TIMEIT_START(batch_spheres);
+	for (unsigned int pass = 0; pass < PASSES_NUM; ++pass) {
+		frustum.SpheresInsideFrustum(centersX.data(), centersY.data(), centersZ.data(), radius.data(),
+				SPHERES_NUM, results.data());
+	}
+	TIMEIT_END(batch_spheres);
+
+	for (SG_Frustum::TestType result : results) {
+		batchInside += (result == SG_Frustum::INSIDE);
+	}
+
+	EXPECT_EQ(scalarInside, batchInside);
+}
@@ -0,0 +1,101 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "SG_Frustum.h"
+
+#include <random>
+#include <vector>
+
+static SG_Frustum test_frustum()
+{
+	const mt::mat4 projection = mt::mat4::Perspective(1.0f, 1.5f, 0.1f, 100.0f);
+	// Camera at origin looking down the -Z axis.
+	return SG_Frustum(projection);
+}
+
+static void test_spheres(const SG_Frustum& frustum, const std::vector<mt::vec4>& spheres)
+{
+	const unsigned int count = spheres.size();
+	const unsigned int size = (count + 3) & ~3;
+	std::vector<float> centersX(size, 0.0f);
+	std::vector<float> centersY(size, 0.0f);
+	std::vector<float> centersZ(size, 0.0f);
+	std::vector<float> radius(size, 0.0f);
+	std::vector<SG_Frustum::TestType> results(size);
+
+	for (unsigned int i = 0; i < count; ++i) {
+		centersX[i] = spheres[i].x;
+		centersY[i] = spheres[i].y;
+		centersZ[i] = spheres[i].z;
+		radius[i] = spheres[i].w;
+	}
+
+	frustum.SpheresInsideFrustum(centersX.data(), centersY.data(), centersZ.data(), radius.data(), count, results.data());
+
+	for (unsigned int i = 0; i < count; ++i) {
+		const SG_Frustum::TestType expected = frustum.SphereInsideFrustum(spheres[i].xyz(), spheres[i].w);
+		/* The scalar test returns the first intersection found while the batch test
+		 * checks all the planes, both agree on inside and on outside spheres found
+		 * by the scalar test. */
+		EXPECT_EQ(expected == SG_Frustum::INSIDE, results[i] == SG_Frustum::INSIDE);
+		if (expected == SG_Frustum::OUTSIDE) {
+			EXPECT_EQ(SG_Frustum::OUTSIDE, results[i]);
+		}
+	}
+}
+
+TEST(SG_Frustum, SpheresInsideFrustumSimple)
+{
+	const SG_Frustum frustum = test_frustum();
+	const std::vector<mt::vec4> spheres = {
+		mt::vec4(0.0f, 0.0f, -10.0f, 1.0f),
+		mt::vec4(0.0f, 0.0f, 10.0f, 1.0f),
+		mt::vec4(-8.2f, 0.0f, -10.0f, 2.0f),
+		mt::vec4(1000.0f, 0.0f, -10.0f, 1.0f),
+		mt::vec4(0.0f, 0.0f, 0.0f, 0.5f)
+	};
+
+	const SG_Frustum::TestType expected[] = {
+		SG_Frustum::INSIDE,
+		SG_Frustum::OUTSIDE,
+		SG_Frustum::INTERSECT,
+		SG_Frustum::OUTSIDE,
+		SG_Frustum::INTERSECT
+	};
+
+	std::vector<float> centersX(8, 0.0f);
+	std::vector<float> centersY(8, 0.0f);
+	std::vector<float> centersZ(8, 0.0f);
+	std::vector<float> radius(8, 0.0f);
+	std::vector<SG_Frustum::TestType> results(8);
+	for (unsigned int i = 0; i < spheres.size(); ++i) {
+		centersX[i] = spheres[i].x;
+		centersY[i] = spheres[i].y;
+		centersZ[i] = spheres[i].z;
+		radius[i] = spheres[i].w;
+	}
+
+	frustum.SpheresInsideFrustum(centersX.data(), centersY.data(), centersZ.data(), radius.data(), spheres.size(), results.data());
+
+	for (unsigned int i = 0; i < spheres.size(); ++i) {
+		EXPECT_EQ(expected[i], results[i]);
+	}
+}
+
+TEST(SG_Frustum, SpheresInsideFrustumRandom)
+{
+	const SG_Frustum frustum = test_frustum();
+
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+	std::uniform_real_distribution<float> size(0.01f, 20.0f);
+
+	// Not a multiple of 4 to test the last partial batch.
+	std::vector<mt::vec4> spheres(10003);
+	for (mt::vec4& sphere : spheres) {
+		sphere = mt::vec4(position(generator), position(generator), position(generator), size(generator));
+	}
+
+	test_spheres(frustum, spheres);
+}
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+"""
+Game engine loop benchmark.
+
+Generates synthetic stress scenes with Blender, steps each of them in the headless player
+with a fixed logic step and an external clock and writes the frame times, the time of every
+profile category and the allocations to a JSON file. A previous result can be passed to
+report the categories slower than a threshold, the exit code is then 1.
+
+./tests/python/bge_benchmark.py --blender ./bin/blender --blenderplayer ./bin/blenderplayer \
+    --count 1000 --frames 500 --output bge_benchmark.json --compare previous.json
+
+The headless player doesn't render, the alpha objects scene then only measures the scene graph
+and culling costs, --render runs the player in a window to measure the rasterizer.
+"""
+
+import argparse
+import json
+import pathlib
+import shutil
+import subprocess
+import sys
+import tempfile
+
+SCENES = ("rigid_bodies", "armatures", "logic_bricks", "python_components", "alpha_objects")
+
+# Categories compared to the previous result, the others depend too much on the system.
+COMPARED_CATEGORIES = ("logic", "physics", "animations", "scenegraph", "rasterizer")
+
+
+def generate_scene(args, scene, filepath):
+    subprocess.run([
+        args.blender, "--background", "-noaudio", "--factory-startup",
+        "--python", str(args.scripts / "bge_benchmark_scenes.py"),
+        "--",
+        "--scene", scene,
+        "--count", str(args.count),
+        "--output", str(filepath),
+    ], check=True, timeout=args.timeout)
+
+
+def run_scene(args, filepath, outputpath):
+    command = [args.blenderplayer]
+    if not args.render:
+        command.append("-b")
+    command += [
+        "-g", "fixedtime", "=", "0",
+        "-g", "unlimited_ticrate", "=", "1",
+        "-p", str(args.scripts / "bge_benchmark_loop.py"),
+        str(filepath),
+        "-",
+        "--output", str(outputpath),
+        "--warmup", str(args.warmup),
+        "--frames", str(args.frames),
+    ]
+    subprocess.run(command, check=True, timeout=args.timeout)
+
+    if not outputpath.exists():
+        raise RuntimeError("%s didn't write any result, the game ended early" % filepath.name)
+
+    with outputpath.open() as f:
+        return json.load(f)
+
+
+def compare(results, previous, threshold):
+    """Print the mean time of the categories compared to a previous result.
+
+    Returns the number of categories slower than the threshold.
+    """
+    regressions = 0
+    for scene, result in sorted(results["scenes"].items()):
+        previous_result = previous["scenes"].get(scene)
+        if previous_result is None:
+            continue
+
+        for category in COMPARED_CATEGORIES:
+            current = result["categories"].get(category, {}).get("mean")
+            reference = previous_result["categories"].get(category, {}).get("mean")
+            # Ignore categories too small to be measured reliably.
+            if current is None or reference is None or reference < 0.01:
+                continue
+
+            ratio = current / reference
+            regressed = ratio > threshold
+            regressions += regressed
+            print("%-20s %-12s %8.3f ms -> %8.3f ms (%+6.1f%%)%s" % (
+                scene, category, reference, current, (ratio - 1.0) * 100.0, "  REGRESSION" if regressed else ""))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--blender', required=True)
+    parser.add_argument('--blenderplayer', required=True)
+    parser.add_argument('--output', required=True)
+    parser.add_argument('--scenes', nargs='+', choices=SCENES, default=SCENES)
+    parser.add_argument('--count', type=int, default=1000, help="Number of objects per scene")
+    parser.add_argument('--warmup', type=int, default=50, help="Number of frames not measured")
+    parser.add_argument('--frames', type=int, default=500, help="Number of frames measured")
+    parser.add_argument('--render', action='store_true', help="Run the player in a window with render")
+    parser.add_argument('--compare', help="Previous result to compare to")
+    parser.add_argument('--threshold', type=float, default=1.1,
+                        help="Time ratio to the previous result above which a category regressed")
+    parser.add_argument('--timeout', type=int, default=600)
+    args = parser.parse_args()
+    args.scripts = pathlib.Path(__file__).resolve().parent
+
+    results = {
+        "count": args.count,
+        "warmup": args.warmup,
+        "frames": args.frames,
+        "render": args.render,
+        "scenes": {},
+    }
+
+    tempdir = pathlib.Path(tempfile.mkdtemp(prefix='blender-bge-benchmark'))
+    try:
+        for scene in args.scenes:
+            filepath = tempdir / (scene + ".blend")
+            generate_scene(args, scene, filepath)
+            results["scenes"][scene] = run_scene(args, filepath, tempdir / (scene + ".json"))
+    finally:
+        shutil.rmtree(str(tempdir))
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+
+    if args.compare:
+        with open(args.compare) as f:
+            previous = json.load(f)
+        if compare(results, previous, args.threshold):
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,110 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+"""
+Python main loop of the game engine benchmark, see bge_benchmark.py.
+
+Steps the engine a fixed number of frames and writes the frame times, the time of every
+profile category and the allocations of the guarded allocator to a JSON file.
+The player must use a fixed logic step and an external clock for deterministic frames:
+
+./blenderplayer -b -g fixedtime = 0 -g unlimited_ticrate = 1 -p tests/python/bge_benchmark_loop.py \
+    /tmp/rigid_bodies.blend - --output /tmp/rigid_bodies.json --warmup 50 --frames 500
+"""
+
+import json
+import math
+import sys
+import time
+
+import bge
+
+
+def statistics(values):
+    values = sorted(values)
+    count = len(values)
+    if count == 0:
+        return {}
+
+    mean = sum(values) / count
+    return {
+        "mean": mean,
+        "median": values[count // 2],
+        "min": values[0],
+        "max": values[-1],
+        "stddev": math.sqrt(sum((value - mean) ** 2 for value in values) / count),
+    }
+
+
+def main():
+    import argparse
+
+    argv = sys.argv[sys.argv.index('-') + 1:] if '-' in sys.argv else []
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--output', required=True)
+    parser.add_argument('--warmup', type=int, default=50)
+    parser.add_argument('--frames', type=int, default=500)
+    args = parser.parse_args(argv)
+
+    logic = bge.logic
+
+    for _ in range(args.warmup):
+        if logic.NextFrame():
+            return
+
+    memory_begin = logic.getMemoryInfo()
+
+    frame_times = []
+    # The profile categories are averaged over the last frames by the engine,
+    # the mean of these averages on all the frames is the mean category time.
+    category_times = {}
+    for _ in range(args.frames):
+        begin = time.perf_counter()
+        stop = logic.NextFrame()
+        frame_times.append((time.perf_counter() - begin) * 1000.0)
+
+        for label, (milliseconds, _) in logic.getProfileInfo().items():
+            name = label.rstrip(':').lower().replace(' ', '_')
+            category_times.setdefault(name, []).append(milliseconds)
+
+        if stop:
+            break
+
+    memory_end = logic.getMemoryInfo()
+
+    result = {
+        "frames": len(frame_times),
+        "frame_time": statistics(frame_times),
+        "categories": {name: statistics(times) for name, times in sorted(category_times.items())},
+        "memory": {
+            "begin": memory_begin["memory"],
+            "end": memory_end["memory"],
+            "peak": memory_end["peak"],
+            "blocks_begin": memory_begin["blocks"],
+            "blocks_end": memory_end["blocks"],
+        },
+    }
+
+    with open(args.output, 'w') as f:
+        json.dump(result, f, indent=2, sort_keys=True)
+
+
+main()
@@ -0,0 +1,250 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+"""
+Generates the synthetic stress scenes of the game engine benchmark, see bge_benchmark.py.
+
+./blender.bin --background -noaudio --factory-startup --python tests/python/bge_benchmark_scenes.py -- \
+    --scene rigid_bodies --count 1000 --output /tmp/rigid_bodies.blend
+"""
+
+import math
+import sys
+
+import bpy
+
+COMPONENT_MODULE = "bge_benchmark_component"
+
+COMPONENT_CODE = '''\
+import bge
+
+
+class Spin(bge.types.KX_PythonComponent):
+    args = {}
+
+    def start(self, args):
+        self.angle = 0.0
+
+    def update(self):
+        self.angle += 0.01
+        self.object.applyRotation((0.0, 0.0, 0.01), True)
+'''
+
+
+def clear_scene(scene):
+    for ob in list(scene.objects):
+        scene.objects.unlink(ob)
+        bpy.data.objects.remove(ob)
+
+
+def new_object(scene, name, data, location):
+    ob = bpy.data.objects.new(name, data)
+    ob.location = location
+    scene.objects.link(ob)
+    return ob
+
+
+def new_mesh(name, verts, faces):
+    mesh = bpy.data.meshes.new(name)
+    mesh.from_pydata(verts, [], faces)
+    mesh.update()
+    return mesh
+
+
+def new_cube_mesh(size=0.5):
+    verts = [(x * size, y * size, z * size) for x in (-1, 1) for y in (-1, 1) for z in (-1, 1)]
+    faces = [(0, 1, 3, 2), (4, 6, 7, 5), (0, 4, 5, 1), (2, 3, 7, 6), (0, 2, 6, 4), (1, 5, 7, 3)]
+    return new_mesh("Cube", verts, faces)
+
+
+def new_plane_mesh(size):
+    verts = [(-size, -size, 0.0), (size, -size, 0.0), (size, size, 0.0), (-size, size, 0.0)]
+    return new_mesh("Plane", verts, [(0, 1, 2, 3)])
+
+
+def grid_locations(count, spacing, height=0.0):
+    """Spread the objects on a square grid centered on the origin."""
+    side = max(1, math.ceil(math.sqrt(count)))
+    offset = (side - 1) * spacing * 0.5
+    return [((i % side) * spacing - offset, (i // side) * spacing - offset, height) for i in range(count)]
+
+
+def add_always_and(ob):
+    """Add an always sensor in pulse mode linked to an and controller."""
+    bpy.ops.logic.sensor_add(type='ALWAYS', object=ob.name)
+    bpy.ops.logic.controller_add(type='LOGIC_AND', object=ob.name)
+    sensor = ob.game.sensors[-1]
+    sensor.use_pulse_true_level = True
+    controller = ob.game.controllers[-1]
+    sensor.link(controller)
+    return controller
+
+
+def add_actuator(ob, controller, type):
+    bpy.ops.logic.actuator_add(type=type, object=ob.name)
+    actuator = ob.game.actuators[-1]
+    controller.link(actuator=actuator)
+    return actuator
+
+
+def add_camera(scene, distance):
+    cam = new_object(scene, "Camera", bpy.data.cameras.new("Camera"), (0.0, -distance, distance))
+    cam.rotation_euler = (math.radians(45.0), 0.0, 0.0)
+    cam.data.clip_end = distance * 4.0
+    scene.camera = cam
+
+
+def create_rigid_bodies(scene, count):
+    """Cubes falling on a ground plane, stacked by layers of 100."""
+    mesh = new_cube_mesh()
+    layer = grid_locations(min(count, 100), 1.5)
+    for i in range(count):
+        x, y, _ = layer[i % len(layer)]
+        ob = new_object(scene, "RigidBody", mesh, (x, y, 1.0 + (i // len(layer)) * 1.5))
+        ob.game.physics_type = 'RIGID_BODY'
+        ob.game.use_collision_bounds = True
+        ob.game.collision_bounds_type = 'BOX'
+
+    new_object(scene, "Ground", new_plane_mesh(50.0), (0.0, 0.0, 0.0))
+    add_camera(scene, 30.0)
+
+
+def create_armatures(scene, count):
+    """Armatures of three bones playing a looping action from an action actuator."""
+    ob = new_object(scene, "Armature", bpy.data.armatures.new("Armature"), (0.0, 0.0, 0.0))
+    scene.objects.active = ob
+    bpy.ops.object.mode_set(mode='EDIT')
+    parent = None
+    for i in range(3):
+        bone = ob.data.edit_bones.new("Bone%i" % i)
+        bone.head = (0.0, 0.0, float(i))
+        bone.tail = (0.0, 0.0, float(i + 1))
+        bone.parent = parent
+        bone.use_connect = parent is not None
+        parent = bone
+    bpy.ops.object.mode_set(mode='OBJECT')
+
+    action = bpy.data.actions.new("Wave")
+    for i in range(3):
+        data_path = 'pose.bones["Bone%i"].rotation_quaternion' % i
+        for index, values in enumerate(((1.0, 0.7, 1.0), (0.0, 0.7, 0.0))):
+            fcurve = action.fcurves.new(data_path, index, "Bone%i" % i)
+            for frame, value in zip((1.0, 10.0, 20.0), values):
+                fcurve.keyframe_points.insert(frame, value)
+
+    controller = add_always_and(ob)
+    actuator = add_actuator(ob, controller, 'ACTION')
+    actuator.action = action
+    actuator.play_mode = 'LOOPEND'
+    actuator.frame_start = 1.0
+    actuator.frame_end = 20.0
+
+    locations = grid_locations(count, 2.0)
+    ob.location = locations[0]
+    for location in locations[1:]:
+        copy = ob.copy()
+        copy.location = location
+        scene.objects.link(copy)
+
+    add_camera(scene, math.sqrt(count) * 2.0)
+
+
+def create_logic_bricks(scene, count):
+    """Empties incrementing a property and rotating from an always sensor."""
+    for location in grid_locations(count, 1.0):
+        ob = new_object(scene, "Logic", None, location)
+        scene.objects.active = ob
+        bpy.ops.object.game_property_new(type='INT', name="counter")
+        ob.game.properties["counter"].value = 0
+
+        controller = add_always_and(ob)
+        actuator = add_actuator(ob, controller, 'PROPERTY')
+        actuator.mode = 'ADD'
+        actuator.property = "counter"
+        actuator.value = "1"
+        actuator = add_actuator(ob, controller, 'MOTION')
+        actuator.offset_rotation = (0.0, 0.0, 0.01)
+
+    add_camera(scene, math.sqrt(count))
+
+
+def create_python_components(scene, count):
+    """Empties rotated by a python component."""
+    text = bpy.data.texts.new(COMPONENT_MODULE + ".py")
+    text.from_string(COMPONENT_CODE)
+
+    for location in grid_locations(count, 1.0):
+        ob = new_object(scene, "Component", None, location)
+        scene.objects.active = ob
+        bpy.ops.logic.add_python_component(component_name=COMPONENT_MODULE + ".Spin")
+
+    add_camera(scene, math.sqrt(count))
+
+
+def create_alpha_objects(scene, count):
+    """Overlapping alpha blended planes rotating in front of the camera."""
+    material = bpy.data.materials.new("Alpha")
+    material.use_transparency = True
+    material.alpha = 0.5
+    material.game_settings.alpha_blend = 'ALPHA_SORT'
+
+    mesh = new_plane_mesh(0.5)
+    mesh.materials.append(material)
+
+    for i, (x, y, _) in enumerate(grid_locations(count, 0.5)):
+        ob = new_object(scene, "Alpha", mesh, (x, y, (i % 10) * 0.1))
+        controller = add_always_and(ob)
+        actuator = add_actuator(ob, controller, 'MOTION')
+        actuator.offset_rotation = (0.0, 0.01, 0.0)
+
+    add_camera(scene, math.sqrt(count) * 0.5 + 2.0)
+
+
+SCENES = {
+    "rigid_bodies": create_rigid_bodies,
+    "armatures": create_armatures,
+    "logic_bricks": create_logic_bricks,
+    "python_components": create_python_components,
+    "alpha_objects": create_alpha_objects,
+}
+
+
+def main():
+    import argparse
+
+    argv = sys.argv[sys.argv.index('--') + 1:] if '--' in sys.argv else []
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--scene', required=True, choices=sorted(SCENES))
+    parser.add_argument('--count', type=int, required=True)
+    parser.add_argument('--output', required=True)
+    args = parser.parse_args(argv)
+
+    scene = bpy.context.scene
+    scene.render.engine = 'BLENDER_GAME'
+    clear_scene(scene)
+
+    SCENES[args.scene](scene, args.count)
+
+    bpy.ops.wm.save_as_mainfile(filepath=args.output, check_existing=False)
+
+
+if __name__ == '__main__':
+    main()